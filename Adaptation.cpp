@@ -0,0 +1,184 @@
+#include "Adaptation.h"
+#include "Limiter.h"
+#include "Decomposition.h"
+#include "Timer.h"
+
+Adaptation::Adaptation(int_t maxLevel, int_t interval, real_t CFL, Type boundary, std::shared_ptr<Zone> zone)
+{
+	if (Decomposition::getSize() > 1) ERROR("adaptive grid runs on a single rank");
+	if (zone->getPolyOrder() == 0) ERROR("adaptive grid needs polynomial order 1 or higher");
+	if ((maxLevel < 0) || (interval < 1)) ERROR("adaptive grid parameters");
+
+	_maxLevel = maxLevel;
+	_interval = interval;
+	_boundary = boundary;
+
+	// Waves cross at most CFL/(2P+1) cells per step
+	_buffer = int_t(interval*CFL / double(2 * zone->getPolyOrder() + 1)) + 1;
+
+	// Base grid is level 0
+	const std::vector<std::shared_ptr<Cell> >& cell = zone->getGrid()->getCell();
+	const int_t num_real = zone->getGrid()->getNumCell() - 2 * GHOST;
+	_level.assign(num_real, 0);
+	_index.resize(num_real);
+	_node.resize(num_real + 1);
+	for (int_t ireal = 0; ireal < num_real; ++ireal)
+	{
+		_index[ireal] = ireal;
+		_node[ireal] = cell[ireal + GHOST]->getPosX() - 0.5*cell[ireal + GHOST]->getSizeX();
+	}
+	_node[num_real] = cell[num_real - 1 + GHOST]->getPosX() + 0.5*cell[num_real - 1 + GHOST]->getSizeX();
+
+	_num_remesh = 0;
+	_num_step = 0;
+	_max_cell = num_real;
+	_sum_cell = 0.0;
+}
+
+Adaptation::~Adaptation()
+{
+
+}
+
+void Adaptation::initialize(std::shared_ptr<Zone>& zone, std::shared_ptr<InitialCondition> initialCondition)
+{
+	// One level per pass, the marker sees the initial condition on the refined grid
+	for (int_t ilevel = 0; ilevel < _maxLevel; ++ilevel)
+	{
+		std::make_shared<Boundary>(_boundary, zone)->apply(zone);
+		std::vector<int_t> target;
+		mark(zone, target);
+		for (size_t ireal = 0; ireal < target.size(); ++ireal)
+			target[ireal] = std::max(_level[ireal], std::min(target[ireal], ilevel + 1));
+		if (target == _level) break;
+		zone = remesh(zone, target);
+		zone->initialize(initialCondition);
+	}
+	_max_cell = _level.size();
+}
+
+bool Adaptation::update(int_t step, std::shared_ptr<Zone>& zone, std::shared_ptr<Boundary> bdry)
+{
+	_num_step++;
+	_sum_cell += _level.size();
+	if (step % _interval != 0) return false;
+
+	TIMER_SCOPE(Phase::Adaptation);
+
+	bdry->apply(zone);
+	std::vector<int_t> target;
+	mark(zone, target);
+	if (target == _level) return false;
+
+	zone = remesh(zone, target);
+	_num_remesh++;
+	_max_cell = std::max(_max_cell, int_t(_level.size()));
+	return true;
+}
+
+void Adaptation::mark(std::shared_ptr<Zone> zone, std::vector<int_t>& target) const
+{
+	const int_t num_real = _level.size();
+
+	// hMLP troubled-cell marker of full degree
+	Limiter limiter("MLP-u2", zone);
+	limiter.computeTrace(zone, 0, zone->getGrid()->getNumCell());
+	std::vector<int_t> troubled(num_real);
+	auto body = [&](int_t begin, int_t end)
+	{
+		for (int_t ireal = begin; ireal < end; ++ireal)
+			troubled[ireal] = limiter.isTroubled(zone, ireal + GHOST);
+	};
+	ThreadPool::parallelFor(0, num_real, body);
+
+	// Troubled cells and buffer go to the finest level, others coarsen by one level
+	target.resize(num_real);
+	for (int_t ireal = 0; ireal < num_real; ++ireal)
+		target[ireal] = std::max(_level[ireal] - 1, int_t(0));
+	for (int_t ireal = 0; ireal < num_real; ++ireal)
+	{
+		if (!troubled[ireal]) continue;
+		for (int_t ibuffer = ireal - _buffer; ibuffer <= ireal + _buffer; ++ibuffer)
+		{
+			int_t index = ibuffer;
+			if (_boundary == "periodic") index = (index + num_real) % num_real;
+			if ((index >= 0) && (index < num_real)) target[index] = _maxLevel;
+		}
+	}
+
+	// Targets only increase, so the loop ends
+	bool changed = true;
+	while (changed)
+	{
+		changed = false;
+
+		// Neighboring cells differ by one level at most
+		for (int_t ireal = 1; ireal < num_real; ++ireal)
+			if (target[ireal] < target[ireal - 1] - 1) { target[ireal] = target[ireal - 1] - 1; changed = true; }
+		for (int_t ireal = num_real - 2; ireal >= 0; --ireal)
+			if (target[ireal] < target[ireal + 1] - 1) { target[ireal] = target[ireal + 1] - 1; changed = true; }
+
+		// Cells coarsen together with their sibling only
+		for (int_t ireal = 0; ireal < num_real; ++ireal)
+		{
+			if (target[ireal] >= _level[ireal]) continue;
+			const int_t sibling = (_index[ireal] % 2 == 0) ? ireal + 1 : ireal - 1;
+			const bool pair = (sibling >= 0) && (sibling < num_real) && (_level[sibling] == _level[ireal]) && (_index[sibling] / 2 == _index[ireal] / 2);
+			if (!pair || (target[sibling] >= _level[sibling])) { target[ireal] = _level[ireal]; changed = true; }
+		}
+	}
+}
+
+std::shared_ptr<Zone> Adaptation::remesh(std::shared_ptr<Zone> zone, const std::vector<int_t>& target)
+{
+	const int_t num_real = _level.size();
+	std::vector<int_t> level, index, source;
+	std::vector<real_t> node(1, _node[0]);
+
+	// New cells with their first source cell, a merged cell takes the next one as well
+	for (int_t ireal = 0; ireal < num_real;)
+	{
+		if (target[ireal] < _level[ireal])
+		{
+			level.push_back(_level[ireal] - 1);
+			index.push_back(_index[ireal] / 2);
+			source.push_back(ireal);
+			node.push_back(_node[ireal + 2]);
+			ireal += 2;
+		}
+		else
+		{
+			const int_t num_child = int_t(1) << (target[ireal] - _level[ireal]);
+			const real_t size = _node[ireal + 1] - _node[ireal];
+			for (int_t ichild = 0; ichild < num_child; ++ichild)
+			{
+				level.push_back(target[ireal]);
+				index.push_back(_index[ireal] * num_child + ichild);
+				source.push_back(ireal);
+				node.push_back((ichild == num_child - 1) ? _node[ireal + 1] : _node[ireal] + size*(ichild + 1) / num_child);
+			}
+			ireal++;
+		}
+	}
+
+	// Project DOF, a merged cell covers two source cells
+	std::shared_ptr<Grid> grid = std::make_shared<Grid>(node, 0, 1);
+	std::shared_ptr<Zone> newZone = std::make_shared<Zone>(grid, zone->getPolyOrder(), (zone->getLayout() == Layout::AoS) ? "AoS" : "SoA");
+	newZone->setAdaptiveOrder(zone->isAdaptiveOrder());
+	auto project = [&](int_t begin, int_t end)
+	{
+		for (int_t inew = begin; inew < end; ++inew)
+		{
+			const int_t first = source[inew] + GHOST;
+			const int_t last = (level[inew] < _level[source[inew]]) ? first + 1 : first;
+			newZone->project(inew + GHOST, zone, first, last);
+		}
+	};
+	ThreadPool::parallelFor(0, int_t(level.size()), project);
+	newZone->calSolution();
+
+	_level = level;
+	_index = index;
+	_node = node;
+	return newZone;
+}
\ No newline at end of file
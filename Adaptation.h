@@ -0,0 +1,59 @@
+#pragma once
+#include "DataType.h"
+#include "Grid.h"
+#include "Zone.h"
+#include "Boundary.h"
+#include "InitialCondition.h"
+
+// Dynamic h-adaptive grid driven by the hMLP troubled-cell marker
+// Every cell keeps a refinement level and its index among the cells of that level, children of cell j are 2j and 2j+1.
+// Every interval steps cells marked troubled and their neighbors within a buffer are split to the finest level,
+// other cells merge with their sibling one level at a time. Neighboring cells differ by one level at most.
+// DOF move to the new cells by L2 projection, the new grid replaces the Zone.
+// Single rank only.
+class Adaptation
+{
+public:
+	// Constructor / p.m. maximum refinement level, remesh interval in steps, CFL number, boundary condition, Zone(object, base grid)
+	Adaptation(int_t, int_t, real_t, Type, std::shared_ptr<Zone>);
+
+	// Destructor
+	~Adaptation();
+
+public:
+	// Functions
+	// Refine initial condition level by level / p.m. Zone(object, replaced), Initial condition(object)
+	void initialize(std::shared_ptr<Zone>&, std::shared_ptr<InitialCondition>);
+
+	// Remesh every interval / p.m. step, Zone(object, replaced when the grid changes), Boundary(object) / r.t. grid changed
+	bool update(int_t, std::shared_ptr<Zone>&, std::shared_ptr<Boundary>);
+
+	inline int_t getNumRemesh() const { return _num_remesh; }
+
+	inline int_t getMaxCell() const { return _max_cell; }
+
+	// Real cells averaged over steps
+	inline int_t getAverageCell() const { return (_num_step > 0) ? int_t(_sum_cell / _num_step) : int_t(_level.size()); }
+
+protected:
+	// Variables
+	int_t _maxLevel;
+	int_t _interval;
+	int_t _buffer; /// cells around troubled cells refined with them
+	Type _boundary;
+	std::vector<int_t> _level; /// real cells
+	std::vector<int_t> _index;
+	std::vector<real_t> _node;
+	int_t _num_remesh;
+	int_t _num_step;
+	int_t _max_cell;
+	real_t _sum_cell;
+
+protected:
+	// Functions
+	// Target level of every real cell / p.m. Zone(object, ghost cells applied), target level(output)
+	void mark(std::shared_ptr<Zone>, std::vector<int_t>&) const;
+
+	// Build grid of target levels and project DOF / p.m. Zone(object), target level / r.t. Zone of new grid
+	std::shared_ptr<Zone> remesh(std::shared_ptr<Zone>, const std::vector<int_t>&);
+};
\ No newline at end of file
@@ -0,0 +1,152 @@
+// Standard thread headers before DataType.h (epsilon macro)
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <deque>
+
+#include "AsyncWriter.h"
+#include "ThreadPool.h"
+#include "Timer.h"
+
+struct AsyncWriter::State
+{
+	// Output waiting for the writer
+	struct Job
+	{
+		int_t buffer;
+		std::string name;
+		real_t time;
+	};
+
+	std::thread writer;
+	std::mutex mutex;
+	std::condition_variable queued; /// job queued or stop
+	std::condition_variable released; /// buffer returned to pool
+	std::deque<Job> queue;
+	std::vector<int_t> available; /// free buffers
+	int_t writing; /// jobs taken by the writer and not finished
+	bool stop;
+
+	State() : writing(0), stop(false) {}
+};
+
+AsyncWriter::AsyncWriter(std::shared_ptr<Post> post, std::shared_ptr<Zone> zone, int_t num_buffer)
+{
+	_post = post;
+	_num_wait = 0;
+	_state = new State;
+	if (num_buffer < 0) ERROR("number of output buffers");
+
+	// Writer thread would only take time from the solver without a spare core
+	if ((num_buffer > 0) && (std::thread::hardware_concurrency() == 1))
+	{
+		MESSAGE("Single core, DG solutions are written synchronously");
+		num_buffer = 0;
+	}
+
+	// Buffers share grid and basis of the solution Zone
+	for (int_t ibuffer = 0; ibuffer < num_buffer; ++ibuffer)
+	{
+		_buffer.push_back(std::make_shared<Zone>(*zone));
+		_state->available.push_back(ibuffer);
+	}
+
+	if (num_buffer > 0) _state->writer = std::thread(&AsyncWriter::loop, this);
+}
+
+AsyncWriter::~AsyncWriter()
+{
+	if (_state->writer.joinable())
+	{
+		{
+			std::lock_guard<std::mutex> lock(_state->mutex);
+			_state->stop = true;
+		}
+		_state->queued.notify_one();
+		_state->writer.join();
+	}
+	delete _state;
+}
+
+void AsyncWriter::DGsolution(const std::string& name, std::shared_ptr<Zone> zone, real_t time)
+{
+	TIMER_SCOPE(Phase::Output);
+
+	// Synchronous output without buffers
+	if (_buffer.empty())
+	{
+		_post->DGsolution(name, zone, time);
+		return;
+	}
+
+	// Take a free buffer, wait for the writer if the pool is exhausted
+	State& state = *_state;
+	int_t ibuffer;
+	{
+		std::unique_lock<std::mutex> lock(state.mutex);
+		if (state.available.empty()) _num_wait++;
+		state.released.wait(lock, [&] { return !state.available.empty(); });
+		ibuffer = state.available.back();
+		state.available.pop_back();
+	}
+
+	// Copy solution into buffer, outside the lock
+	std::shared_ptr<Zone>& buffer = _buffer[ibuffer];
+	auto copy = [&](int_t begin, int_t end)
+	{
+		buffer->getDOF().assign(zone->getDOF(), begin, end);
+		std::copy(zone->getDescSolution().begin() + begin, zone->getDescSolution().begin() + end, buffer->getDescSolution().begin() + begin);
+	};
+	ThreadPool::parallelFor(0, zone->getGrid()->getNumCell(), copy);
+
+	{
+		std::lock_guard<std::mutex> lock(state.mutex);
+		State::Job job = { ibuffer, name, time };
+		state.queue.push_back(job);
+	}
+	state.queued.notify_one();
+}
+
+void AsyncWriter::flush()
+{
+	if (_buffer.empty()) return;
+
+	State& state = *_state;
+	std::unique_lock<std::mutex> lock(state.mutex);
+	state.released.wait(lock, [&] { return state.queue.empty() && (state.writing == 0); });
+}
+
+void AsyncWriter::reshape(std::shared_ptr<Zone> zone)
+{
+	// Writer is idle after flush, buffers are free
+	flush();
+	for (size_t ibuffer = 0; ibuffer < _buffer.size(); ++ibuffer)
+		_buffer[ibuffer] = std::make_shared<Zone>(*zone);
+}
+
+void AsyncWriter::loop()
+{
+	State& state = *_state;
+	while (true)
+	{
+		State::Job job;
+		{
+			std::unique_lock<std::mutex> lock(state.mutex);
+			state.queued.wait(lock, [&] { return !state.queue.empty() || state.stop; });
+			if (state.queue.empty()) return; /// stop after queue is drained
+			job = state.queue.front();
+			state.queue.pop_front();
+			state.writing++;
+		}
+
+		// Format and write without holding the lock
+		_post->DGsolution(job.name, _buffer[job.buffer], job.time);
+
+		{
+			std::lock_guard<std::mutex> lock(state.mutex);
+			state.writing--;
+			state.available.push_back(job.buffer);
+		}
+		state.released.notify_all();
+	}
+}
\ No newline at end of file
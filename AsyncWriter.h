@@ -0,0 +1,54 @@
+#pragma once
+#include "DataType.h"
+#include "Zone.h"
+#include "Post.h"
+
+// Asynchronous DG solution output
+// At an output point the DOF are copied into a free Zone buffer of a bounded pool and the solver keeps marching.
+// A background thread formats and writes the buffer through Post, the buffer returns to the pool afterwards.
+// When every buffer is waiting to be written the solver blocks until one is free (backpressure).
+// The writer thread never calls the thread pool, which serves the solver only.
+class AsyncWriter
+{
+public:
+	// Constructor / p.m. Post(object), Zone(object, shape of buffers), number of buffers(0 : synchronous output)
+	AsyncWriter(std::shared_ptr<Post>, std::shared_ptr<Zone>, int_t);
+
+	// Destructor, waits for pending output
+	~AsyncWriter();
+
+public:
+	// Functions
+	// Queue DG solution output / p.m. file name, Zone(object), time
+	void DGsolution(const std::string&, std::shared_ptr<Zone>, real_t);
+
+	// Wait until every queued output is written
+	void flush();
+
+	// Buffers of new grid, waits for pending output / p.m. Zone(object)
+	void reshape(std::shared_ptr<Zone>);
+
+	inline int_t getNumBuffer() const { return _buffer.size(); }
+
+	// Number of outputs that waited for a free buffer
+	inline int_t getNumWait() const { return _num_wait; }
+
+protected:
+	// Variables
+	std::shared_ptr<Post> _post;
+	std::vector<std::shared_ptr<Zone> > _buffer;
+	int_t _num_wait;
+
+	// Queue and writer thread
+	struct State;
+	State* _state;
+
+protected:
+	// Functions
+	// Writer thread loop
+	void loop();
+
+private:
+	AsyncWriter(const AsyncWriter&);
+	AsyncWriter& operator=(const AsyncWriter&);
+};
\ No newline at end of file
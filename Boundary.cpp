@@ -1,4 +1,6 @@
 #include "Boundary.h"
+#include "Decomposition.h"
+#include "Timer.h"
 
 Boundary::Boundary(Type type, std::shared_ptr<Zone> zone)
 {
@@ -14,8 +16,8 @@ Boundary::Boundary(Type type, std::shared_ptr<Zone> zone)
 
 	for (int_t idegree = 0; idegree <= zone->getPolyOrder(); ++idegree)
 	{
-		_beginDOF[idegree] = zone->getDOF()[idegree][GHOST];
-		_endDOF[idegree] = zone->getDOF()[idegree][_num_cell - 1 - GHOST];
+		_beginDOF[idegree] = zone->getDOF()(idegree, GHOST);
+		_endDOF[idegree] = zone->getDOF()(idegree, _num_cell - 1 - GHOST);
 	}
 }
 
@@ -24,41 +26,86 @@ Boundary::~Boundary()
 
 }
 
+void Boundary::save(std::vector<real_t>& state) const
+{
+	// begin, end, begin DOF, end DOF
+	state.clear();
+	state.push_back(_begin);
+	state.push_back(_end);
+	state.insert(state.end(), _beginDOF.begin(), _beginDOF.end());
+	state.insert(state.end(), _endDOF.begin(), _endDOF.end());
+}
+
+void Boundary::load(const std::vector<real_t>& state)
+{
+	if (int_t(state.size()) != 2 * (_polyOrder + 2)) ERROR("boundary state");
+	_begin = state[0];
+	_end = state[1];
+	std::copy(state.begin() + 2, state.begin() + 2 + _polyOrder + 1, _beginDOF.begin());
+	std::copy(state.begin() + 2 + _polyOrder + 1, state.end(), _endDOF.begin());
+}
+
 void Boundary::apply(std::shared_ptr<Zone>& zone)
 {
-	std::vector<real_t> temp_solution = zone->getDescSolution();
-	std::vector<std::vector<real_t> > temp_DOF = zone->getDOF();
+	TIMER_SCOPE(Phase::Boundary);
+
+	// Ghost cells are written in place
+	std::vector<real_t>& solution = zone->getDescSolution();
+	DOFArray& DOF = zone->getDOF();
+
+	// Decomposed domain : rank interfaces(and periodic ends) by halo exchange
+	if (Decomposition::getSize() > 1)
+	{
+		if ((_type != "constant") && (_type != "periodic")) ERROR("cannot find proper boundary condition");
+		Decomposition::beginExchange(zone, _type == "periodic");
+
+		// Constant condition on domain ends while messages are in flight
+		if (_type == "constant")
+		{
+			bool first = (Decomposition::getRank() == 0);
+			bool last = (Decomposition::getRank() == Decomposition::getSize() - 1);
+			for (int_t icell = 0; icell < GHOST; ++icell)
+			{
+				if (first) solution[icell] = _begin;
+				if (last) solution[_num_cell - 1 - icell] = _end;
+				for (int_t idegree = 0; idegree <= _polyOrder; ++idegree)
+				{
+					if (first) DOF(idegree, icell) = _beginDOF[idegree];
+					if (last) DOF(idegree, _num_cell - 1 - icell) = _endDOF[idegree];
+				}
+			}
+		}
+
+		Decomposition::endExchange(zone);
+		return;
+	}
 
 	if (_type == "constant")
 	{
 		for (int_t icell = 0; icell < GHOST; ++icell)
 		{
-			temp_solution[icell] = _begin;
-			temp_solution[_num_cell - 1 - icell] = _end;
+			solution[icell] = _begin;
+			solution[_num_cell - 1 - icell] = _end;
 			for (int_t idegree = 0; idegree <= _polyOrder; ++idegree)
 			{
-				temp_DOF[idegree][icell] = _beginDOF[idegree];
-				temp_DOF[idegree][_num_cell - 1 - icell] = _endDOF[idegree];
+				DOF(idegree, icell) = _beginDOF[idegree];
+				DOF(idegree, _num_cell - 1 - icell) = _endDOF[idegree];
 			}
 		}
-		zone->setDescSolution(temp_solution);
-		zone->setDOF(temp_DOF);
 	}
 
 	else if (_type == "periodic")
 	{
 		for (int_t icell = 0; icell < GHOST; ++icell)
 		{
-			temp_solution[icell] = zone->getDescSolution()[_num_cell - 2*GHOST + icell];
-			temp_solution[_num_cell - GHOST + icell] = zone->getDescSolution()[icell + GHOST];
+			solution[icell] = solution[_num_cell - 2*GHOST + icell];
+			solution[_num_cell - GHOST + icell] = solution[icell + GHOST];
 			for (int_t idegree = 0; idegree <= _polyOrder; ++idegree)
 			{
-				temp_DOF[idegree][icell] = zone->getDOF()[idegree][_num_cell - 2*GHOST + icell];
-				temp_DOF[idegree][_num_cell - GHOST + icell] = zone->getDOF()[idegree][icell + GHOST];
+				DOF(idegree, icell) = DOF(idegree, _num_cell - 2*GHOST + icell);
+				DOF(idegree, _num_cell - GHOST + icell) = DOF(idegree, icell + GHOST);
 			}
 		}
-		zone->setDescSolution(temp_solution);
-		zone->setDOF(temp_DOF);
 	}
 
 	else ERROR("cannot find proper boundary condition");
@@ -15,6 +15,14 @@ public:
 	// Functions
 	void apply(std::shared_ptr<Zone>&);
 
+	inline Type getType() const { return _type; }
+
+	// Stored boundary states for checkpoint / p.m. states(output)
+	void save(std::vector<real_t>&) const;
+
+	// Restore stored boundary states / p.m. states of save
+	void load(const std::vector<real_t>&);
+
 protected:
 	// Variables
 	int_t _num_cell;
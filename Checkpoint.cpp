@@ -0,0 +1,177 @@
+// Standard headers before DataType.h (epsilon macro)
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#if !defined(_WIN32)
+#include <unistd.h>
+#endif
+
+#include "Checkpoint.h"
+#include "Decomposition.h"
+#include "Timer.h"
+
+#define CHECKPOINT_MAGIC "RKDGCKP"
+#define CHECKPOINT_VERSION 2
+
+// Wall-clock in seconds
+static real_t wallClock()
+{
+	return std::chrono::duration<real_t>(std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+Checkpoint::Checkpoint(std::shared_ptr<Reader> reader)
+{
+	_reader = reader;
+	_fileName = rankFile("./output/test/RKDG_1D_checkpoint.rkc");
+	_step = reader->getCheckpointStep();
+	_wallTime = reader->getCheckpointWallTime();
+	_lastWrite = wallClock();
+	if ((_step < 0) || (_wallTime < 0.0)) ERROR("checkpoint interval");
+}
+
+Checkpoint::~Checkpoint()
+{
+
+}
+
+std::string Checkpoint::rankFile(const std::string& fileName)
+{
+	if (Decomposition::getSize() == 1) return fileName;
+	const size_t dot = fileName.rfind('.');
+	const std::string rank = "_rank" + std::to_string(Decomposition::getRank());
+	if (dot == std::string::npos) return fileName + rank;
+	return fileName.substr(0, dot) + rank + fileName.substr(dot);
+}
+
+bool Checkpoint::update(int_t step, std::shared_ptr<Zone> zone, std::shared_ptr<TimeInteg> timeInteg, std::shared_ptr<Boundary> bdry)
+{
+	TIMER_SCOPE(Phase::Checkpoint);
+	bool due = (_step > 0) && (step % _step == 0);
+
+	// Clocks of ranks differ, every rank follows the slowest
+	if (_wallTime > 0.0)
+	{
+		const real_t elapsed = Decomposition::maxAll(wallClock() - _lastWrite);
+		if (elapsed >= _wallTime) due = true;
+	}
+	if (!due) return false;
+
+	write(step, zone, timeInteg, bdry);
+	_lastWrite = wallClock();
+	return true;
+}
+
+void Checkpoint::write(int_t step, std::shared_ptr<Zone> zone, std::shared_ptr<TimeInteg> timeInteg, std::shared_ptr<Boundary> bdry) const
+{
+	const int_t num_cell = zone->getGrid()->getNumCell();
+	const int_t num_mode = zone->getPolyOrder() + 1;
+	const std::string& input = _reader->getInput();
+
+	std::vector<real_t> boundary;
+	bdry->save(boundary);
+
+	CheckpointHeader header;
+	std::memset(&header, 0, sizeof(header));
+	std::memcpy(header.magic, CHECKPOINT_MAGIC, sizeof(CHECKPOINT_MAGIC));
+	header.version = CHECKPOINT_VERSION;
+	header.rank = Decomposition::getRank();
+	header.size = Decomposition::getSize();
+	header.polyOrder = zone->getPolyOrder();
+	header.numCell = num_cell;
+	header.step = step;
+	header.inputLength = input.size();
+	header.boundaryLength = boundary.size();
+	header.currentTime = timeInteg->getTime();
+	header.timeStep = timeInteg->getTimeStep();
+
+	// DOF in [mode][cell] order regardless of layout
+	std::vector<real_t> buffer(num_mode*num_cell + num_cell);
+	for (int_t imode = 0; imode < num_mode; ++imode)
+		for (int_t icell = 0; icell < num_cell; ++icell)
+			buffer[imode*num_cell + icell] = zone->getDOF()(imode, icell);
+	std::copy(zone->getDescSolution().begin(), zone->getDescSolution().end(), buffer.begin() + num_mode*num_cell);
+	std::vector<int32_t> degree(zone->getDegree().begin(), zone->getDegree().end());
+
+	// Write temporary file, flushed to disk before it replaces the checkpoint
+	const std::string temp = _fileName + ".tmp";
+	FILE* file = std::fopen(temp.c_str(), "wb");
+	if (file == nullptr) ERROR("cannot open checkpoint file");
+	bool written = (std::fwrite(&header, sizeof(header), 1, file) == 1);
+	written = written && (std::fwrite(input.data(), 1, input.size(), file) == input.size());
+	written = written && (std::fwrite(boundary.data(), sizeof(real_t), boundary.size(), file) == boundary.size());
+	written = written && (std::fwrite(buffer.data(), sizeof(real_t), buffer.size(), file) == buffer.size());
+	written = written && (std::fwrite(degree.data(), sizeof(int32_t), degree.size(), file) == degree.size());
+	written = written && (std::fflush(file) == 0);
+#if !defined(_WIN32)
+	written = written && (fsync(fileno(file)) == 0);
+#endif
+	written = (std::fclose(file) == 0) && written;
+	if (!written)
+	{
+		std::remove(temp.c_str());
+		ERROR("cannot write checkpoint");
+	}
+
+#if defined(_WIN32)
+	// rename does not replace an existing file
+	std::remove(_fileName.c_str());
+#endif
+	if (std::rename(temp.c_str(), _fileName.c_str()) != 0) ERROR("cannot replace checkpoint");
+	MESSAGE("Checkpoint at iteration " + std::to_string(step) + " : " + _fileName);
+}
+
+void Checkpoint::readHeader(std::ifstream& file, CheckpointHeader& header)
+{
+	file.read(reinterpret_cast<char*>(&header), sizeof(header));
+	if (!file || (std::memcmp(header.magic, CHECKPOINT_MAGIC, sizeof(CHECKPOINT_MAGIC)) != 0)) ERROR("not a checkpoint file");
+	if ((header.version != 1) && (header.version != CHECKPOINT_VERSION)) ERROR("checkpoint version");
+	if ((header.size != Decomposition::getSize()) || (header.rank != Decomposition::getRank())) ERROR("checkpoint written by other number of ranks");
+}
+
+std::string Checkpoint::readInput(const std::string& fileName)
+{
+	std::ifstream file(fileName, std::ios::binary);
+	if (!file.is_open()) ERROR("cannot open checkpoint file");
+
+	CheckpointHeader header;
+	readHeader(file, header);
+	std::string input(size_t(header.inputLength), '\0');
+	file.read(&input[0], input.size());
+	if (!file) ERROR("cannot read checkpoint");
+	return input;
+}
+
+int_t Checkpoint::restore(const std::string& fileName, std::shared_ptr<Zone> zone, std::shared_ptr<TimeInteg> timeInteg, std::shared_ptr<Boundary> bdry)
+{
+	std::ifstream file(fileName, std::ios::binary);
+	if (!file.is_open()) ERROR("cannot open checkpoint file");
+
+	CheckpointHeader header;
+	readHeader(file, header);
+	const int_t num_cell = zone->getGrid()->getNumCell();
+	const int_t num_mode = zone->getPolyOrder() + 1;
+	if ((header.polyOrder != zone->getPolyOrder()) || (header.numCell != num_cell)) ERROR("checkpoint does not match grid");
+
+	// Input text was read by readInput
+	file.seekg(header.inputLength, std::ios::cur);
+
+	std::vector<real_t> boundary(size_t(header.boundaryLength));
+	std::vector<real_t> buffer(num_mode*num_cell + num_cell);
+	std::vector<int32_t> degree((header.version == 1) ? 0 : num_cell);
+	file.read(reinterpret_cast<char*>(boundary.data()), boundary.size()*sizeof(real_t));
+	file.read(reinterpret_cast<char*>(buffer.data()), buffer.size()*sizeof(real_t));
+	file.read(reinterpret_cast<char*>(degree.data()), degree.size()*sizeof(int32_t));
+	if (!file) ERROR("cannot read checkpoint");
+
+	bdry->load(boundary);
+	for (int_t imode = 0; imode < num_mode; ++imode)
+		for (int_t icell = 0; icell < num_cell; ++icell)
+			zone->getDOF()(imode, icell) = buffer[imode*num_cell + icell];
+	std::copy(buffer.begin() + num_mode*num_cell, buffer.begin() + (num_mode + 1)*num_cell, zone->getDescSolution().begin());
+	if (header.version == 1) std::fill(zone->getDegree().begin(), zone->getDegree().end(), zone->getPolyOrder());
+	else std::copy(degree.begin(), degree.end(), zone->getDegree().begin());
+	timeInteg->restart(header.currentTime, header.timeStep);
+
+	MESSAGE("Restart from iteration " + std::to_string(header.step) + ", time = " + std::to_string(header.currentTime));
+	return int_t(header.step);
+}
\ No newline at end of file
@@ -0,0 +1,69 @@
+#pragma once
+#include <cstdint>
+#include "DataType.h"
+#include "Reader.h"
+#include "Zone.h"
+#include "TimeInteg.h"
+#include "Boundary.h"
+
+// Checkpoint of full integrator state for restart
+// Layout : CheckpointHeader, input text, boundary states, DOF[mode][cell], discrete solution[cell], order of cell[cell](int32)
+// Version 1 files have no order of cells, every cell has the order of the run.
+// Every cell including ghost cells is stored, so a restarted run continues bit-for-bit.
+// A checkpoint is written to a temporary file and renamed over the previous one, an interrupted write never destroys it.
+struct CheckpointHeader
+{
+	char magic[8]; /// "RKDGCKP"
+	int32_t version;
+	int32_t rank;
+	int32_t size; /// number of ranks
+	int32_t polyOrder;
+	int64_t numCell; /// cells of this rank including ghost cells
+	int64_t step;
+	int64_t inputLength; /// bytes of input text
+	int64_t boundaryLength; /// values of boundary states
+	real_t currentTime;
+	real_t timeStep;
+};
+
+class Checkpoint
+{
+public:
+	// Constructor / p.m. Reader(object)
+	Checkpoint(std::shared_ptr<Reader>);
+
+	// Destructor
+	~Checkpoint();
+
+public:
+	// Functions
+	// Write checkpoint when step or wall-clock interval is passed / p.m. step, Zone(object), TimeInteg(object), Boundary(object) / r.t. written
+	bool update(int_t, std::shared_ptr<Zone>, std::shared_ptr<TimeInteg>, std::shared_ptr<Boundary>);
+
+	// Write checkpoint / p.m. step, Zone(object), TimeInteg(object), Boundary(object)
+	void write(int_t, std::shared_ptr<Zone>, std::shared_ptr<TimeInteg>, std::shared_ptr<Boundary>) const;
+
+	// Restore integrator state / p.m. file name, Zone(object), TimeInteg(object), Boundary(object) / r.t. step
+	static int_t restore(const std::string&, std::shared_ptr<Zone>, std::shared_ptr<TimeInteg>, std::shared_ptr<Boundary>);
+
+	// Input text of checkpoint / p.m. file name
+	static std::string readInput(const std::string&);
+
+	// Checkpoint file of this rank / p.m. file name of rank 0
+	static std::string rankFile(const std::string&);
+
+	inline const std::string& getFileName() const { return _fileName; }
+
+protected:
+	// Variables
+	std::shared_ptr<Reader> _reader;
+	std::string _fileName;
+	int_t _step; /// step interval, 0 : off
+	real_t _wallTime; /// wall-clock interval in seconds, 0 : off
+	real_t _lastWrite; /// wall-clock of last write in seconds
+
+protected:
+	// Functions
+	// Read header and check it against this run / p.m. file stream, header(output)
+	static void readHeader(std::ifstream&, CheckpointHeader&);
+};
\ No newline at end of file
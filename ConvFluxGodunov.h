@@ -2,6 +2,7 @@
 #include "DataType.h"
 #include "ConvFlux.h"
 #include "ConvPhyFlux.h"
+#include "FluxPolicy.h"
 
 class ConvFluxGodunov : public ConvFlux
 {
@@ -16,4 +17,9 @@ public:
 	// Functions
 	// Compute flux / p.m. begin, end
 	virtual real_t computeFlux(real_t, real_t) const;
+
+protected:
+	// Variables
+	// Godunov flux of the PDE, selected at construction
+	real_t(*_fluxFtn)(real_t, real_t);
 };
\ No newline at end of file
@@ -36,20 +36,5 @@ real_t ConvPhyFlux::phyCharSpeed(const std::string& name, real_t u)
 	}
 }
 
-real_t ConvPhyFlux::burgers(real_t u)
-{
-	return 0.5*u*u;
-}
-
-real_t ConvPhyFlux::advection(real_t u)
-{
-	return _advSpeed*u;
-}
-
-real_t ConvPhyFlux::burgersChar(real_t u)
-{
-	return u;
-}
-
 real_t ConvPhyFlux::_advSpeed;
 ConvPhyFlux ConvPhyFlux::_phyFlux;
\ No newline at end of file
@@ -19,14 +19,15 @@ public:
 	// Compute characteristic speed / p.m. physical flux name, solution variable
 	static real_t phyCharSpeed(const std::string&, real_t);
 
-protected:
-	// Physical fluxes
-	static real_t burgers(real_t);
-	static real_t advection(real_t);
+	// Physical fluxes / p.m. solution variable
+	static inline real_t burgers(real_t u) { return 0.5*u*u; }
+
+	static inline real_t advection(real_t u) { return _advSpeed*u; }
 
-	// Physical characteristic speed
-	static real_t burgersChar(real_t);
+	// Physical characteristic speed / p.m. solution variable
+	static inline real_t burgersChar(real_t u) { return u; }
 
+protected:
 	// Advection speed
 	static real_t _advSpeed;
 
@@ -38,9 +39,9 @@ private:
 // Convective Physical Flux macro
 #define PHY_FLUX(name, u) ConvPhyFlux::phyFlux(name, u)
 
-#define PHY_FLUX_BURGERS(u) ConvPhyFlux::phyFlux("burgers", u)
+#define PHY_FLUX_BURGERS(u) ConvPhyFlux::burgers(u)
 
-#define PHY_FLUX_ADVEC(u) ConvPhyFlux::phyFlux("advection", u)
+#define PHY_FLUX_ADVEC(u) ConvPhyFlux::advection(u)
 
 #define PHY_CHAR_SPEED(name, u) ConvPhyFlux::phyCharSpeed(name, u)
 
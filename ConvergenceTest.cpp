@@ -0,0 +1,165 @@
+// Standard chrono header before DataType.h (epsilon macro)
+#include <chrono>
+#include <iomanip>
+
+#include "ConvergenceTest.h"
+#include "Grid.h"
+#include "Zone.h"
+#include "InitialCondition.h"
+#include "Boundary.h"
+#include "OrderTest.h"
+#include "TimeIntegEuler.h"
+#include "TimeIntegRK.h"
+#include "ThreadPool.h"
+#include "Decomposition.h"
+
+ConvergenceTest::ConvergenceTest(std::shared_ptr<Reader> reader)
+{
+	_reader = reader;
+
+	// Polynomial order of input file without order list
+	std::vector<int_t> polyOrder = reader->getConvOrder();
+	if (polyOrder.empty()) polyOrder.push_back(reader->getPolyOrder());
+
+	// Levels ordered by polynomial order, grid sizes in input order
+	for (size_t iorder = 0; iorder < polyOrder.size(); ++iorder)
+	{
+		for (size_t isize = 0; isize < reader->getConvSizeX().size(); ++isize)
+		{
+			Level level = {};
+			level.polyOrder = polyOrder[iorder];
+			level.sizeX = reader->getConvSizeX()[isize];
+			if ((level.polyOrder < 0) || (level.sizeX <= 0.0)) ERROR("convergence level");
+			_level.push_back(level);
+		}
+	}
+}
+
+ConvergenceTest::~ConvergenceTest()
+{
+
+}
+
+void ConvergenceTest::run()
+{
+	if (Decomposition::getSize() > 1) ERROR("convergence test runs on a single rank");
+	if (_level.empty()) ERROR("no convergence level");
+	MESSAGE("Convergence test of " + std::to_string(_level.size()) + " levels");
+
+	// Schedule costly levels first : cells x time steps ~ ((P+1)/dx)^2
+	std::vector<int_t> schedule(_level.size());
+	for (size_t ilevel = 0; ilevel < schedule.size(); ++ilevel) schedule[ilevel] = ilevel;
+	auto cost = [&](int_t ilevel) { return pow((_level[ilevel].polyOrder + 1) / _level[ilevel].sizeX, 2.0); };
+	std::stable_sort(schedule.begin(), schedule.end(), [&](int_t a, int_t b) { return cost(a) > cost(b); });
+
+	// Messages of concurrent levels would interleave
+	Alert::setSilent(true);
+	auto body = [&](int_t itask) { solve(_level[schedule[itask]]); };
+	ThreadPool::parallelTask(_level.size(), body);
+	Alert::setSilent(false);
+
+	print();
+}
+
+void ConvergenceTest::solve(Level& level) const
+{
+	std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+
+	// Same objects as a single run of Main
+	std::shared_ptr<Grid> grid = std::make_shared<Grid>(_reader->getArea(), level.sizeX);
+	std::shared_ptr<Zone> zone = std::make_shared<Zone>(grid, level.polyOrder, _reader->getDOFLayout());
+	std::shared_ptr<OrderTest> orderTest = std::make_shared<OrderTest>();
+	if (_reader->getBasis() == "nodal") zone->setNodal(true);
+	else if (_reader->getBasis() != "modal") ERROR("cannot find basis");
+	zone->initialize(std::make_shared<InitialCondition>(_reader->getInitial()));
+	std::shared_ptr<Boundary> bdry = std::make_shared<Boundary>(_reader->getBoundary(), zone);
+	orderTest->setExact(orderTest->ZoneToPoly(zone));
+
+	std::shared_ptr<TimeInteg> timeInteg;
+	if (_reader->getTimeInteg() == "Euler")
+		timeInteg = std::make_shared<TimeIntegEuler>
+		(_reader->getPDE(), _reader->getFluxScheme(), _reader->getLimiter(), _reader->getCFL(), _reader->getTargetT(), zone, bdry);
+	else if (_reader->getTimeInteg() == "RK3")
+		timeInteg = std::make_shared<TimeIntegRK>
+		(_reader->getPDE(), _reader->getFluxScheme(), _reader->getLimiter(), _reader->getCFL(), _reader->getTargetT(), zone, bdry, 3);
+	else ERROR("cannot find time integrator");
+
+	// Time marching, last call of march also advances
+	level.num_step = 1;
+	while (timeInteg->march(zone)) level.num_step++;
+
+	// Compute L errors
+	std::vector<real_t> computed = orderTest->ZoneToPoly(zone);
+	level.num_cell = grid->getNumGlobalCell();
+	level.L1 = orderTest->L1error(computed);
+	level.L2 = orderTest->L2error(computed);
+	level.Linf = orderTest->Linf_error(computed);
+
+	level.wallTime = std::chrono::duration<real_t>(std::chrono::steady_clock::now() - start).count();
+}
+
+real_t ConvergenceTest::observedOrder(int_t ilevel, real_t Level::* error) const
+{
+	if ((ilevel == 0) || (_level[ilevel - 1].polyOrder != _level[ilevel].polyOrder)) return 0.0;
+
+	const Level& coarse = _level[ilevel - 1];
+	const Level& fine = _level[ilevel];
+	return log(coarse.*error / fine.*error) / log(coarse.sizeX / fine.sizeX);
+}
+
+void ConvergenceTest::print() const
+{
+	// Determine file name
+	std::string fileName = "./output/test/";
+	fileName += "RKDG_1D_convergence_";
+	fileName += _reader->getPDE();
+	fileName += "_";
+	fileName += _reader->getInitial();
+	fileName += ".dat";
+
+	std::ofstream file;
+	file.open(fileName, std::ios::trunc);
+	if (!file.is_open()) ERROR("cannot open output file");
+	file << "P\tdx\tcells\tsteps\tL1\tL1 order\tL2\tL2 order\tLinf\tLinf order\twall time(s)\n";
+	file.precision(16);
+
+	std::cout << "----------Convergence----------\n";
+	std::cout << std::setw(3) << "P" << std::setw(11) << "dx" << std::setw(8) << "cells" << std::setw(8) << "steps"
+		<< std::setw(13) << "L1" << std::setw(7) << "order" << std::setw(13) << "L2" << std::setw(7) << "order"
+		<< std::setw(13) << "Linf" << std::setw(7) << "order" << std::setw(11) << "time(s)" << "\n";
+
+	for (int_t ilevel = 0; ilevel < int_t(_level.size()); ++ilevel)
+	{
+		const Level& level = _level[ilevel];
+		bool first = (ilevel == 0) || (_level[ilevel - 1].polyOrder != level.polyOrder);
+		real_t order[3] = { observedOrder(ilevel, &Level::L1), observedOrder(ilevel, &Level::L2), observedOrder(ilevel, &Level::Linf) };
+		real_t error[3] = { level.L1, level.L2, level.Linf };
+
+		// Table file, first grid of each order has no observed order
+		file << level.polyOrder << "\t" << level.sizeX << "\t" << level.num_cell << "\t" << level.num_step;
+		for (int_t ierror = 0; ierror < 3; ++ierror)
+		{
+			file << "\t" << error[ierror] << "\t";
+			if (first) file << "-";
+			else file << order[ierror];
+		}
+		file << "\t" << level.wallTime << "\n";
+
+		// Screen
+		std::cout << std::setw(3) << level.polyOrder << std::setw(11) << level.sizeX << std::setw(8) << level.num_cell << std::setw(8) << level.num_step;
+		for (int_t ierror = 0; ierror < 3; ++ierror)
+		{
+			std::cout << std::scientific << std::setprecision(4) << std::setw(13) << error[ierror];
+			std::cout << std::fixed << std::setprecision(2) << std::setw(7);
+			if (first) std::cout << "-";
+			else std::cout << order[ierror];
+		}
+		std::cout << std::fixed << std::setprecision(3) << std::setw(11) << level.wallTime << "\n";
+		std::cout.unsetf(std::ios::floatfield);
+		std::cout << std::setprecision(6);
+	}
+	std::cout << "-------------------------------\n";
+
+	file.close();
+	MESSAGE("Convergence table : " + fileName);
+}
\ No newline at end of file
@@ -0,0 +1,51 @@
+#pragma once
+#include "DataType.h"
+#include "Reader.h"
+
+// Grid-refinement convergence study
+// Every (polynomial order, grid size) pair of the input is one level, solved as a complete run of its own.
+// Levels run concurrently on the thread pool, costly levels first, and each level marches serially.
+// Errors come from OrderTest, observed orders compare each level with the previous grid size of the same order.
+class ConvergenceTest
+{
+public:
+	// Constructor / p.m. Reader(object)
+	ConvergenceTest(std::shared_ptr<Reader>);
+
+	// Destructor
+	~ConvergenceTest();
+
+public:
+	// Functions
+	// Solve every level, print table and write it to file
+	void run();
+
+protected:
+	// Result of one level
+	struct Level
+	{
+		int_t polyOrder;
+		real_t sizeX;
+		int_t num_cell; /// number of real cells
+		int_t num_step;
+		real_t L1;
+		real_t L2;
+		real_t Linf;
+		real_t wallTime; /// seconds
+	};
+
+	// Variables
+	std::shared_ptr<Reader> _reader;
+	std::vector<Level> _level;
+
+protected:
+	// Functions
+	// Solve one level / p.m. level(input order and grid size, output results)
+	void solve(Level&) const;
+
+	// Observed order of accuracy against previous level of same order / p.m. level index, error of level / r.t. 0 for first grid
+	real_t observedOrder(int_t, real_t Level::*) const;
+
+	// Print table and write file
+	void print() const;
+};
\ No newline at end of file
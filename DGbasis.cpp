@@ -1,15 +1,26 @@
 #include "DGbasis.h"
+#include "Quadrature.h"
 
 DGbasis::DGbasis(int_t order, std::shared_ptr<Grid> grid)
 {
 	_grid = grid;
 	_cell = grid->getCell();
-	_sizeX = grid->getSizeX();
-	_coeff.resize(order + 1);
-	_coeff[0] = 1.0;
-	if (order > 0) _coeff[1] = 12.0 / _sizeX;
-	if (order > 1) _coeff[2] = 180.0 / pow(_sizeX, 2.0);
-	if (order > 2) ERROR("Exceed maximum polynomial order");
+	_num_mode = order + 1;
+
+	// Coefficients of every cell from its own size, (2n+1)/(scale^2*sizeX^n) with integer 1/scale
+	_coeff.resize(_cell.size()*_num_mode);
+	for (size_t icell = 0; icell < _cell.size(); ++icell)
+	{
+		const real_t sizeX = _cell[icell]->getSizeX();
+		real_t* coeff = &_coeff[icell*_num_mode];
+		coeff[0] = 1.0;
+		real_t inv_scale = 1.0;
+		for (int_t idegree = 1; idegree <= order; ++idegree)
+		{
+			inv_scale = inv_scale*2.0*(2 * idegree - 1) / double(idegree);
+			coeff[idegree] = (2 * idegree + 1)*inv_scale*inv_scale / pow(sizeX, double(idegree));
+		}
+	}
 }
 
 DGbasis::~DGbasis()
@@ -23,7 +34,64 @@ real_t DGbasis::basis(int_t degree, int_t index, real_t x)
 	{
 	case 0: return 1.0;
 	case 1: return (x - _cell[index]->getPosX());
-	case 2: return (pow(x - _cell[index]->getPosX(), 2.0) - pow(_sizeX, 2.0) / 12.0);
-	default: return 0.0;
+	case 2: return (pow(x - _cell[index]->getPosX(), 2.0) - pow(_cell[index]->getSizeX(), 2.0) / 12.0);
+	default:
+	{
+		// scale*(sizeX^degree)*Legendre of reference coordinate
+		const real_t sizeX = _cell[index]->getSizeX();
+		return legendreScale(degree)*pow(sizeX, double(degree))*legendre(degree, 2.0*(x - _cell[index]->getPosX()) / sizeX);
+	}
+	}
+}
+
+real_t DGbasis::legendre(int_t degree, real_t xi)
+{
+	// Bonnet's recursion
+	real_t P0 = 1.0;
+	real_t P1 = xi;
+	if (degree == 0) return P0;
+	for (int_t n = 1; n < degree; ++n)
+	{
+		real_t P2 = ((2 * n + 1)*xi*P1 - n*P0) / double(n + 1);
+		P0 = P1;
+		P1 = P2;
+	}
+	return P1;
+}
+
+real_t DGbasis::legendreDeriv(int_t degree, real_t xi)
+{
+	// dP(n+1)/dx = dP(n-1)/dx + (2n+1)P(n)
+	real_t dP0 = 0.0;
+	real_t dP1 = 1.0;
+	if (degree == 0) return dP0;
+	for (int_t n = 1; n < degree; ++n)
+	{
+		real_t dP2 = dP0 + (2 * n + 1)*legendre(n, xi);
+		dP0 = dP1;
+		dP1 = dP2;
 	}
+	return dP1;
+}
+
+real_t DGbasis::legendreScale(int_t degree)
+{
+	// (n!)^2/(2n)!
+	real_t scale = 1.0;
+	for (int_t n = 1; n <= degree; ++n)
+		scale *= n / double(2 * (2 * n - 1));
+	return scale;
+}
+
+real_t DGbasis::modeAtNode(int_t order, int_t degree, int_t node)
+{
+	return (2 * degree + 1) / legendreScale(degree)*legendre(degree, Lobatto_X(order + 1, node));
+}
+
+real_t DGbasis::nodeToMode(int_t order, int_t degree, int_t node)
+{
+	// Discrete norm of Legendre polynomial of the order is 2/P instead of 2/(2P+1) on order+1 nodes
+	real_t mode = 0.5*legendreScale(degree)*Lobatto_W(order + 1, node)*legendre(degree, Lobatto_X(order + 1, node));
+	if (degree == order) mode *= order / double(2 * order + 1);
+	return mode;
 }
\ No newline at end of file
@@ -13,15 +13,31 @@ public:
 
 public:
 	// Functions
-	inline vector_d getCoeff() const { return _coeff; }
+	// Normalization of basis function, depends on cell size / p.m. degree, cell index
+	inline real_t getCoeff(int_t degree, int_t index) const { return _coeff[index*_num_mode + degree]; }
 
 	// Basis function / p.m. degree, cell index, x coordinate
 	real_t basis(int_t, int_t, real_t);
 
+	// Legendre polynomial on reference cell [-1, 1] / p.m. degree, reference coordinate
+	static real_t legendre(int_t, real_t);
+
+	// Derivative of Legendre polynomial on reference cell / p.m. degree, reference coordinate
+	static real_t legendreDeriv(int_t, real_t);
+
+	// Basis function to Legendre polynomial ratio, basis = scale*(sizeX^degree)*Legendre / p.m. degree
+	static real_t legendreScale(int_t);
+
+	// Basis function times its coefficient at Gauss-Lobatto node, modal DOF to nodal value / p.m. polynomial order, degree, node index
+	static real_t modeAtNode(int_t, int_t, int_t);
+
+	// Gauss-Lobatto quadrature of basis function, nodal value to modal DOF exact for polynomials of the order / p.m. polynomial order, degree, node index
+	static real_t nodeToMode(int_t, int_t, int_t);
+
 protected:
 	// Variables
 	std::shared_ptr<Grid> _grid;
 	std::vector<std::shared_ptr<Cell> > _cell;
-	std::vector<real_t> _coeff;
-	real_t _sizeX;
+	std::vector<real_t> _coeff; /// [cell][degree]
+	int_t _num_mode;
 };
\ No newline at end of file
@@ -0,0 +1,61 @@
+#include "DOFArray.h"
+
+DOFArray::DOFArray()
+{
+	_num_mode = _num_cell = 0;
+	_modeStride = _cellStride = 0;
+	_layout = Layout::SoA;
+}
+
+DOFArray::DOFArray(int_t num_mode, int_t num_cell, Layout layout)
+{
+	_num_mode = num_mode;
+	_num_cell = num_cell;
+	_layout = layout;
+
+	if (_layout == Layout::SoA)
+	{
+		// Pad each mode so that every mode starts on a cache line
+		const int_t pack = DOF_ALIGN / sizeof(real_t);
+		_modeStride = ((num_cell + pack - 1) / pack) * pack;
+		_cellStride = 1;
+	}
+	else
+	{
+		_modeStride = 1;
+		_cellStride = num_mode;
+	}
+
+	_data.assign(_layout == Layout::SoA ? num_mode*_modeStride : num_cell*_cellStride, 0.0);
+}
+
+DOFArray::~DOFArray()
+{
+
+}
+
+void DOFArray::fill(real_t value)
+{
+	std::fill(_data.begin(), _data.end(), value);
+}
+
+void DOFArray::assign(const DOFArray& DOF)
+{
+	if ((DOF._num_mode != _num_mode) || (DOF._num_cell != _num_cell) || (DOF._layout != _layout))
+		ERROR("DOF shape does not match");
+
+	std::copy(DOF._data.begin(), DOF._data.end(), _data.begin());
+}
+
+void DOFArray::assign(const DOFArray& DOF, int_t begin, int_t end)
+{
+	if ((DOF._num_mode != _num_mode) || (DOF._num_cell != _num_cell) || (DOF._layout != _layout))
+		ERROR("DOF shape does not match");
+
+	if (_layout == Layout::SoA)
+	{
+		for (int_t imode = 0; imode < _num_mode; ++imode)
+			std::copy(DOF._data.begin() + imode*_modeStride + begin, DOF._data.begin() + imode*_modeStride + end, _data.begin() + imode*_modeStride + begin);
+	}
+	else std::copy(DOF._data.begin() + begin*_cellStride, DOF._data.begin() + end*_cellStride, _data.begin() + begin*_cellStride);
+}
\ No newline at end of file
@@ -0,0 +1,152 @@
+#pragma once
+#include "DataType.h"
+
+#ifdef _MSC_VER
+#include <malloc.h>
+#else
+#include <cstdlib>
+#endif
+
+// Alignment of DOF storage in bytes (cache line)
+#define DOF_ALIGN 64
+
+// DOF memory layout
+// SoA : [mode][cell], AoS : [cell][mode]
+enum class Layout { SoA, AoS };
+
+// Aligned allocator for contiguous DOF storage
+template <typename T, std::size_t Align>
+class AlignedAllocator
+{
+public:
+	typedef T value_type;
+
+	template <typename U>
+	struct rebind { typedef AlignedAllocator<U, Align> other; };
+
+	AlignedAllocator() {}
+
+	template <typename U>
+	AlignedAllocator(const AlignedAllocator<U, Align>&) {}
+
+	T* allocate(std::size_t num)
+	{
+		void* ptr = nullptr;
+		std::size_t bytes = ((num * sizeof(T) + Align - 1) / Align) * Align;
+#ifdef _MSC_VER
+		ptr = _aligned_malloc(bytes, Align);
+#else
+		if (posix_memalign(&ptr, Align, bytes) != 0) ptr = nullptr;
+#endif
+		if (ptr == nullptr) throw std::bad_alloc();
+		return static_cast<T*>(ptr);
+	}
+
+	void deallocate(T* ptr, std::size_t)
+	{
+#ifdef _MSC_VER
+		_aligned_free(ptr);
+#else
+		free(ptr);
+#endif
+	}
+
+	template <typename U>
+	bool operator==(const AlignedAllocator<U, Align>&) const { return true; }
+
+	template <typename U>
+	bool operator!=(const AlignedAllocator<U, Align>&) const { return false; }
+};
+
+// Strided zero-copy view of DOF storage
+template <typename T>
+class DOFView
+{
+public:
+	// Constructor / p.m. first element, stride, number of elements
+	DOFView(T* data, int_t stride, int_t size) : _data(data), _stride(stride), _size(size) {}
+
+public:
+	// Functions
+	inline T& operator[](int_t index) const { return _data[index*_stride]; }
+
+	inline T* data() const { return _data; }
+
+	inline int_t getStride() const { return _stride; }
+
+	inline int_t size() const { return _size; }
+
+protected:
+	// Variables
+	T* _data;
+	int_t _stride;
+	int_t _size;
+};
+
+class DOFArray
+{
+public:
+	// Constructor
+	DOFArray();
+
+	// Constructor / p.m. number of modes, number of cells, memory layout
+	DOFArray(int_t, int_t, Layout);
+
+	// Destructor
+	~DOFArray();
+
+public:
+	// Functions
+	inline int_t getNumMode() const { return _num_mode; }
+
+	inline int_t getNumCell() const { return _num_cell; }
+
+	inline Layout getLayout() const { return _layout; }
+
+	// Stride between consecutive modes / cells
+	inline int_t getModeStride() const { return _modeStride; }
+
+	inline int_t getCellStride() const { return _cellStride; }
+
+	inline real_t* data() { return _data.data(); }
+
+	inline const real_t* data() const { return _data.data(); }
+
+	// Element access / p.m. mode, cell index
+	inline real_t& operator()(int_t imode, int_t icell) { return _data[imode*_modeStride + icell*_cellStride]; }
+
+	inline real_t operator()(int_t imode, int_t icell) const { return _data[imode*_modeStride + icell*_cellStride]; }
+
+	// All cells of one mode / p.m. mode
+	inline DOFView<real_t> mode(int_t imode) { return DOFView<real_t>(_data.data() + imode*_modeStride, _cellStride, _num_cell); }
+
+	inline DOFView<const real_t> mode(int_t imode) const { return DOFView<const real_t>(_data.data() + imode*_modeStride, _cellStride, _num_cell); }
+
+	// All modes of one cell / p.m. cell index
+	inline DOFView<real_t> cell(int_t icell) { return DOFView<real_t>(_data.data() + icell*_cellStride, _modeStride, _num_mode); }
+
+	inline DOFView<const real_t> cell(int_t icell) const { return DOFView<const real_t>(_data.data() + icell*_cellStride, _modeStride, _num_mode); }
+
+	// DOF[mode][cell] access
+	inline DOFView<real_t> operator[](int_t imode) { return mode(imode); }
+
+	inline DOFView<const real_t> operator[](int_t imode) const { return mode(imode); }
+
+	// Set every DOF / p.m. value
+	void fill(real_t);
+
+	// Copy values from DOF of the same shape without reallocation / p.m. DOF
+	void assign(const DOFArray&);
+
+	// Copy values of a cell range from DOF of the same shape / p.m. DOF, begin cell, end cell(exclusive)
+	void assign(const DOFArray&, int_t, int_t);
+
+protected:
+	// Variables
+	std::vector<real_t, AlignedAllocator<real_t, DOF_ALIGN> > _data;
+	int_t _num_mode;
+	int_t _num_cell;
+	int_t _modeStride;
+	int_t _cellStride;
+	Layout _layout;
+};
\ No newline at end of file
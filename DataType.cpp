@@ -21,7 +21,9 @@ void Alert::error(const std::string& str, const std::string& file, int_t line)
 
 void Alert::message(const std::string& str)
 {
-	std::cout << "## " << str << "\n";
+	if (_silent) return;
+	std::cout << ("## " + str + "\n"); /// one insertion, lines of writer thread do not interleave
 }
 
-Alert Alert::_alert;
\ No newline at end of file
+Alert Alert::_alert;
+bool Alert::_silent = false;
\ No newline at end of file
@@ -8,6 +8,7 @@
 #include <array>
 #include <string>
 #include <memory>
+#include <algorithm>
 
 // Define condition type
 // e.g. initial condition, flux, etc
@@ -25,6 +26,7 @@ typedef double real_t;
 // Frequently used constants
 #define epsilon 1.0e-8
 
+// Sample points per cell of output and error measurement
 #define QuadDegree 3
 
 #define GHOST 3
@@ -33,11 +35,6 @@ typedef double real_t;
 
 #define BOUND_M 10
 
-// Local projection coefficients
-#define PROJEC_COEFF1 1.0
-#define PROJEC_COEFF2 6.0
-#define PROJEC_COEFF3 30.0
-
 const real_t CONST13 = 1.0 / 3.0;
 
 const real_t CONST23 = 2.0 / 3.0;
@@ -66,9 +63,13 @@ public:
 	static void error(const std::string& str, const std::string& file, int_t line);
 	static void message(const std::string& str);
 
+	// Suppress messages(e.g. on non-root ranks) / p.m. true/false
+	static void setSilent(bool silent) { _silent = silent; }
+
 private:
 	// Alert variable
 	static Alert _alert;
+	static bool _silent;
 };
 
 // Message macro
@@ -0,0 +1,179 @@
+#ifdef RKDG_USE_MPI
+#include <mpi.h>
+#endif
+
+#include "Decomposition.h"
+
+struct Decomposition::State
+{
+	int_t rank;
+	int_t size;
+
+#ifdef RKDG_USE_MPI
+	// Neighbor ranks of the current exchange, MPI_PROC_NULL at domain ends
+	int left;
+	int right;
+	MPI_Request request[4];
+	std::vector<real_t> sendLeft;
+	std::vector<real_t> sendRight;
+	std::vector<real_t> recvLeft;
+	std::vector<real_t> recvRight;
+#endif
+
+	State() : rank(0), size(1) {}
+};
+
+Decomposition::Decomposition()
+{
+	_state = new State;
+}
+
+Decomposition::~Decomposition()
+{
+	delete _state;
+}
+
+void Decomposition::initialize(int* argc, char*** argv)
+{
+#ifdef RKDG_USE_MPI
+	int rank, size;
+	MPI_Init(argc, argv);
+	MPI_Comm_rank(MPI_COMM_WORLD, &rank);
+	MPI_Comm_size(MPI_COMM_WORLD, &size);
+	_decomp._state->rank = rank;
+	_decomp._state->size = size;
+#else
+	(void)argc;
+	(void)argv;
+#endif
+}
+
+void Decomposition::finalize()
+{
+#ifdef RKDG_USE_MPI
+	MPI_Finalize();
+#endif
+}
+
+int_t Decomposition::getRank()
+{
+	return _decomp._state->rank;
+}
+
+int_t Decomposition::getSize()
+{
+	return _decomp._state->size;
+}
+
+void Decomposition::partition(int_t num_global, int_t rank, int_t size, int_t& begin, int_t& num)
+{
+	// Balanced slabs, first (num_global % size) ranks own one more cell
+	int_t base = num_global / size;
+	int_t rest = num_global % size;
+	begin = rank*base + std::min(rank, rest);
+	num = base + ((rank < rest) ? 1 : 0);
+
+	// Halo of one interface comes from one neighbor
+	if ((size > 1) && (num < GHOST)) ERROR("too many ranks for number of cells");
+}
+
+real_t Decomposition::maxAll(real_t value)
+{
+#ifdef RKDG_USE_MPI
+	real_t result;
+	MPI_Allreduce(&value, &result, 1, MPI_DOUBLE, MPI_MAX, MPI_COMM_WORLD);
+	return result;
+#else
+	return value;
+#endif
+}
+
+real_t Decomposition::sumAll(real_t value)
+{
+#ifdef RKDG_USE_MPI
+	real_t result;
+	MPI_Allreduce(&value, &result, 1, MPI_DOUBLE, MPI_SUM, MPI_COMM_WORLD);
+	return result;
+#else
+	return value;
+#endif
+}
+
+void Decomposition::beginExchange(std::shared_ptr<Zone> zone, bool periodic)
+{
+#ifdef RKDG_USE_MPI
+	State& state = *_decomp._state;
+	if (state.size == 1) return; /// shared buffers stay untouched for concurrent single-rank runs
+	const int_t num_cell = zone->getGrid()->getNumCell();
+	const int_t num_var = zone->getPolyOrder() + 2; /// DOF and discrete solution
+	const DOFArray& DOF = zone->getDOF();
+	const std::vector<real_t>& solution = zone->getDescSolution();
+
+	// Neighbor ranks
+	state.left = (state.rank > 0) ? state.rank - 1 : (periodic ? state.size - 1 : MPI_PROC_NULL);
+	state.right = (state.rank < state.size - 1) ? state.rank + 1 : (periodic ? 0 : MPI_PROC_NULL);
+
+	// Message buffers, allocated on first use
+	state.sendLeft.resize(GHOST*num_var);
+	state.sendRight.resize(GHOST*num_var);
+	state.recvLeft.resize(GHOST*num_var);
+	state.recvRight.resize(GHOST*num_var);
+
+	// First and last GHOST owned cells
+	for (int_t icell = 0; icell < GHOST; ++icell)
+	{
+		for (int_t idegree = 0; idegree < num_var - 1; ++idegree)
+		{
+			state.sendLeft[icell*num_var + idegree] = DOF(idegree, GHOST + icell);
+			state.sendRight[icell*num_var + idegree] = DOF(idegree, num_cell - 2*GHOST + icell);
+		}
+		state.sendLeft[icell*num_var + num_var - 1] = solution[GHOST + icell];
+		state.sendRight[icell*num_var + num_var - 1] = solution[num_cell - 2*GHOST + icell];
+	}
+
+	// Tag 0 : moving right, tag 1 : moving left
+	const int count = GHOST*num_var;
+	MPI_Irecv(state.recvLeft.data(), count, MPI_DOUBLE, state.left, 0, MPI_COMM_WORLD, &state.request[0]);
+	MPI_Irecv(state.recvRight.data(), count, MPI_DOUBLE, state.right, 1, MPI_COMM_WORLD, &state.request[1]);
+	MPI_Isend(state.sendRight.data(), count, MPI_DOUBLE, state.right, 0, MPI_COMM_WORLD, &state.request[2]);
+	MPI_Isend(state.sendLeft.data(), count, MPI_DOUBLE, state.left, 1, MPI_COMM_WORLD, &state.request[3]);
+#else
+	(void)zone;
+	(void)periodic;
+#endif
+}
+
+void Decomposition::endExchange(std::shared_ptr<Zone> zone)
+{
+#ifdef RKDG_USE_MPI
+	State& state = *_decomp._state;
+	if (state.size == 1) return;
+	const int_t num_cell = zone->getGrid()->getNumCell();
+	const int_t num_var = zone->getPolyOrder() + 2;
+	DOFArray& DOF = zone->getDOF();
+	std::vector<real_t>& solution = zone->getDescSolution();
+
+	MPI_Waitall(4, state.request, MPI_STATUSES_IGNORE);
+
+	// Ghost cells without neighbor rank are left untouched
+	for (int_t icell = 0; icell < GHOST; ++icell)
+	{
+		if (state.left != MPI_PROC_NULL)
+		{
+			for (int_t idegree = 0; idegree < num_var - 1; ++idegree)
+				DOF(idegree, icell) = state.recvLeft[icell*num_var + idegree];
+			solution[icell] = state.recvLeft[icell*num_var + num_var - 1];
+		}
+		if (state.right != MPI_PROC_NULL)
+		{
+			for (int_t idegree = 0; idegree < num_var - 1; ++idegree)
+				DOF(idegree, num_cell - GHOST + icell) = state.recvRight[icell*num_var + idegree];
+			solution[num_cell - GHOST + icell] = state.recvRight[icell*num_var + num_var - 1];
+		}
+	}
+#else
+	(void)zone;
+#endif
+}
+
+Decomposition Decomposition::_decomp;
\ No newline at end of file
@@ -0,0 +1,53 @@
+#pragma once
+#include "DataType.h"
+#include "Zone.h"
+
+// Domain decomposition into rank-local slabs of cells
+// Compiled with RKDG_USE_MPI : one slab per MPI rank, GHOST layers of rank interfaces are filled by non-blocking halo exchange.
+// Otherwise a single rank owns every cell and all functions reduce to the serial case.
+class Decomposition
+{
+protected:
+	Decomposition();
+	~Decomposition();
+
+public:
+	// Initialize MPI / p.m. argc, argv of main
+	static void initialize(int*, char***);
+
+	// Finalize MPI
+	static void finalize();
+
+	static int_t getRank();
+
+	static int_t getSize();
+
+	static bool isRoot() { return getRank() == 0; }
+
+	// Slab of a rank / p.m. number of global cells, rank, number of ranks, first cell(output), number of cells(output)
+	static void partition(int_t, int_t, int_t, int_t&, int_t&);
+
+	// Global maximum / p.m. local value
+	static real_t maxAll(real_t);
+
+	// Global sum / p.m. local value
+	static real_t sumAll(real_t);
+
+	// Post halo exchange / p.m. Zone(object), also exchange across domain ends(periodic)
+	static void beginExchange(std::shared_ptr<Zone>, bool);
+
+	// Wait for halo exchange and fill ghost cells / p.m. Zone(object)
+	static void endExchange(std::shared_ptr<Zone>);
+
+	// Halo exchange on rank interfaces only / p.m. Zone(object)
+	static void exchange(std::shared_ptr<Zone> zone) { beginExchange(zone, false); endExchange(zone); }
+
+protected:
+	// Communicator state and message buffers
+	struct State;
+	State* _state;
+
+private:
+	// Decomposition variable
+	static Decomposition _decomp;
+};
\ No newline at end of file
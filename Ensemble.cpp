@@ -0,0 +1,588 @@
+#include "Ensemble.h"
+#include "ThreadPool.h"
+#include "Limiter.h"
+#include <sstream>
+
+Ensemble::Ensemble(Type PDEtype, Type limiterType, Type boundary, Type initial, real_t targetTime, std::shared_ptr<Grid> grid, int_t polyOrder)
+{
+	_PDEtype = PDEtype; _limiterType = limiterType;
+	_boundary = boundary; _initial = initial;
+	_targetTime = targetTime;
+	_grid = grid;
+	_polyOrder = polyOrder;
+	_num_cell = grid->getNumCell();
+	if (!grid->isUniform()) ERROR("ensemble needs a uniform grid");
+	if (polyOrder > 2) ERROR("ensemble supports polynomial order 2 or lower");
+	_size_cell = grid->getMinSizeX();
+	_width = 0;
+
+	// DG basis
+	_basis = std::make_shared<DGbasis>(_polyOrder, _grid);
+
+	if ((_PDEtype != "advection") && (_PDEtype != "burgers")) ERROR("cannot find physical flux");
+	if ((_limiterType != "none") && (_limiterType != "MLP-u1") && (_limiterType != "MLP-u2")) ERROR("cannot find limiter");
+	if ((_boundary != "constant") && (_boundary != "periodic")) ERROR("cannot find proper boundary condition");
+}
+
+Ensemble::~Ensemble()
+{
+
+}
+
+std::shared_ptr<Ensemble> Ensemble::create(int_t width, Type PDEtype, Type limiterType, Type boundary, Type initial, real_t targetTime, std::shared_ptr<Grid> grid, int_t polyOrder)
+{
+	switch (width)
+	{
+	case 4: return std::make_shared<EnsembleWidth<4> >(PDEtype, limiterType, boundary, initial, targetTime, grid, polyOrder);
+	case 8: return std::make_shared<EnsembleWidth<8> >(PDEtype, limiterType, boundary, initial, targetTime, grid, polyOrder);
+	default:
+		ERROR("ensemble width should be 4 or 8");
+		return nullptr;
+	}
+}
+
+std::vector<EnsembleCase> Ensemble::readCases(const std::string& name)
+{
+	std::vector<EnsembleCase> cases;
+	std::ifstream file(name);
+	if (!file.is_open()) ERROR("cannot open ensemble file");
+
+	// Lines starting with ! or # are comments
+	std::string text;
+	while (std::getline(file, text))
+	{
+		std::istringstream line(text);
+		EnsembleCase member;
+		if ((text.find_first_of("!#") == 0) || !(line >> member.speed >> member.amplitude >> member.CFL)) continue;
+		cases.push_back(member);
+	}
+
+	return cases;
+}
+
+template <int_t W>
+EnsembleWidth<W>::EnsembleWidth(Type PDEtype, Type limiterType, Type boundary, Type initial, real_t targetTime, std::shared_ptr<Grid> grid, int_t polyOrder)
+	: Ensemble(PDEtype, limiterType, boundary, initial, targetTime, grid, polyOrder)
+{
+	_width = W;
+	_currentTime.assign(W, 0.0);
+	_num_step.assign(W, 0);
+
+	// Lane storage
+	const int_t num_mode = _polyOrder + 1;
+	_DOF.assign(_num_cell*num_mode*W, 0.0);
+	_saved_DOF = _stage_DOF = _prev_DOF = _temp_DOF[0] = _temp_DOF[1] = _RHS = _limit_DOF = _DOF;
+	_solution.assign(_num_cell*W, 0.0);
+	_saved_solution = _stage_solution = _flux = _solution;
+	_projectDegree.assign(_num_cell*W, 0);
+	_marker.assign(_num_cell*W, 1);
+	_beginDOF.assign(num_mode*W, 0.0);
+	_endDOF.assign(num_mode*W, 0.0);
+
+	// RHS tables
+	_faceLeft.resize(num_mode); _faceRight.resize(num_mode);
+	_surfLeft.resize(num_mode); _surfRight.resize(num_mode);
+	_basisQuad.resize(num_mode*QuadDegree); _volume.resize(num_mode*QuadDegree);
+	for (int_t idegree = 0; idegree <= _polyOrder; ++idegree)
+	{
+		real_t scale = DGbasis::legendreScale(idegree);
+		real_t sign = (idegree % 2 == 0) ? 1.0 : -1.0;
+
+		_faceLeft[idegree] = sign*(2 * idegree + 1) / scale;
+		_faceRight[idegree] = (2 * idegree + 1) / scale;
+		_surfLeft[idegree] = sign*scale;
+		_surfRight[idegree] = -scale;
+		for (int_t iquad = 0; iquad < QuadDegree; ++iquad)
+		{
+			_basisQuad[idegree*QuadDegree + iquad] = (2 * idegree + 1) / scale*DGbasis::legendre(idegree, Gauss3_X(iquad));
+			_volume[idegree*QuadDegree + iquad] = scale*Gauss3_W(iquad)*DGbasis::legendreDeriv(idegree, Gauss3_X(iquad));
+		}
+	}
+
+	for (int_t lane = 0; lane < W; ++lane)
+	{
+		_speed[lane] = _CFL[lane] = _timeStep[lane] = _begin[lane] = _end[lane] = 0.0;
+		_active[lane] = _finish[lane] = false;
+	}
+}
+
+template <int_t W>
+void EnsembleWidth<W>::initialize(const std::vector<EnsembleCase>& cases)
+{
+	if (cases.empty() || (int_t(cases.size()) > W)) ERROR("number of ensemble cases");
+
+	// Scratch Zone : same projection of initial condition as a single case
+	std::shared_ptr<Zone> zone = std::make_shared<Zone>(_grid, _polyOrder);
+	for (int_t lane = 0; lane < W; ++lane)
+	{
+		// Lanes without case repeat the first case and stay inactive
+		const EnsembleCase& member = cases[(lane < int_t(cases.size())) ? lane : 0];
+		_speed[lane] = member.speed;
+		_CFL[lane] = member.CFL;
+		_active[lane] = (lane < int_t(cases.size()));
+		_finish[lane] = false;
+		_timeStep[lane] = 0.0;
+		_currentTime[lane] = 0.0;
+		_num_step[lane] = 0;
+
+		zone->initialize(std::make_shared<InitialCondition>(_initial, member.amplitude));
+		for (int_t icell = 0; icell < _num_cell; ++icell)
+		{
+			for (int_t idegree = 0; idegree <= _polyOrder; ++idegree)
+				_DOF[index(icell, idegree) + lane] = zone->getDOF()(idegree, icell);
+			_solution[icell*W + lane] = zone->getDescSolution()[icell];
+		}
+
+		// Constant boundary values
+		_begin[lane] = zone->getDescSolution()[GHOST];
+		_end[lane] = zone->getDescSolution()[_num_cell - 1 - GHOST];
+		for (int_t idegree = 0; idegree <= _polyOrder; ++idegree)
+		{
+			_beginDOF[idegree*W + lane] = zone->getDOF()(idegree, GHOST);
+			_endDOF[idegree*W + lane] = zone->getDOF()(idegree, _num_cell - 1 - GHOST);
+		}
+	}
+}
+
+template <int_t W>
+void EnsembleWidth<W>::extract(int_t lane, std::shared_ptr<Zone> zone) const
+{
+	if ((lane < 0) || (lane >= W)) ERROR("ensemble lane");
+
+	for (int_t icell = 0; icell < _num_cell; ++icell)
+	{
+		for (int_t idegree = 0; idegree <= _polyOrder; ++idegree)
+			zone->getDOF()(idegree, icell) = _DOF[index(icell, idegree) + lane];
+		zone->getDescSolution()[icell] = _solution[icell*W + lane];
+	}
+}
+
+template <int_t W>
+bool EnsembleWidth<W>::march()
+{
+	const int_t num_cell = _num_cell;
+	const int_t num_mode = _polyOrder + 1;
+
+	// Time step and termination of each lane
+	bool procedure = false;
+	for (int_t lane = 0; lane < W; ++lane)
+	{
+		if (!_active[lane]) { _timeStep[lane] = 0.0; continue; }
+		procedure = true;
+		if ((_currentTime[lane] + _timeStep[lane]) > _targetTime)
+		{
+			_timeStep[lane] = _targetTime - _currentTime[lane];
+			_finish[lane] = true;
+		}
+	}
+	if (!procedure) return false;
+	computeTimeStep();
+
+	// Copy solution to stage arrays for TVD Runge-Kutta time integration
+	auto copyZone = [&](int_t begin, int_t end)
+	{
+		std::copy(_DOF.begin() + index(begin, 0), _DOF.begin() + index(end, 0), _stage_DOF.begin() + index(begin, 0));
+		std::copy(_DOF.begin() + index(begin, 0), _DOF.begin() + index(end, 0), _saved_DOF.begin() + index(begin, 0));
+		std::copy(_solution.begin() + begin*W, _solution.begin() + end*W, _stage_solution.begin() + begin*W);
+		std::copy(_solution.begin() + begin*W, _solution.begin() + end*W, _saved_solution.begin() + begin*W);
+	};
+	ThreadPool::parallelFor(0, num_cell, copyZone);
+
+	// ----------------------First step--------------------------
+	applyBoundary(_stage_DOF, _stage_solution);
+	hMLP_Limiter(_stage_DOF, _stage_solution);
+	_prev_DOF = _stage_DOF;
+	computeRHS(_stage_DOF);
+
+	auto firstStep = [&](int_t begin, int_t end)
+	{
+		for (int_t icell = begin; icell < end; ++icell)
+		{
+			for (int_t idegree = 0; idegree < num_mode; ++idegree)
+			{
+				const int_t offset = index(icell, idegree);
+				for (int_t lane = 0; lane < W; ++lane)
+				{
+					_temp_DOF[0][offset + lane] = _prev_DOF[offset + lane] + _timeStep[lane] * _RHS[offset + lane];
+					_stage_DOF[offset + lane] = _temp_DOF[0][offset + lane];
+				}
+			}
+		}
+		calSolution(_stage_DOF, _stage_solution, begin, end);
+	};
+	ThreadPool::parallelFor(0, num_cell, firstStep);
+
+	// ---------------------Second step---------------------------
+	applyBoundary(_stage_DOF, _stage_solution);
+	hMLP_Limiter(_stage_DOF, _stage_solution);
+	computeRHS(_stage_DOF);
+
+	auto secondStep = [&](int_t begin, int_t end)
+	{
+		for (int_t icell = begin; icell < end; ++icell)
+		{
+			for (int_t idegree = 0; idegree < num_mode; ++idegree)
+			{
+				const int_t offset = index(icell, idegree);
+				for (int_t lane = 0; lane < W; ++lane)
+				{
+					_temp_DOF[1][offset + lane] = 0.75*_prev_DOF[offset + lane] + 0.25*(_temp_DOF[0][offset + lane] + _timeStep[lane] * _RHS[offset + lane]);
+					_stage_DOF[offset + lane] = _temp_DOF[1][offset + lane];
+				}
+			}
+		}
+		calSolution(_stage_DOF, _stage_solution, begin, end);
+	};
+	ThreadPool::parallelFor(0, num_cell, secondStep);
+
+	// ----------------------Third step---------------------------
+	applyBoundary(_stage_DOF, _stage_solution);
+	hMLP_Limiter(_stage_DOF, _stage_solution);
+	computeRHS(_stage_DOF);
+
+	auto thirdStep = [&](int_t begin, int_t end)
+	{
+		for (int_t icell = begin; icell < end; ++icell)
+		{
+			for (int_t idegree = 0; idegree < num_mode; ++idegree)
+			{
+				const int_t offset = index(icell, idegree);
+				for (int_t lane = 0; lane < W; ++lane)
+					_DOF[offset + lane] = CONST13*_prev_DOF[offset + lane] + CONST23*(_temp_DOF[1][offset + lane] + _timeStep[lane] * _RHS[offset + lane]);
+			}
+		}
+	};
+	ThreadPool::parallelFor(0, num_cell, thirdStep);
+
+	// Apply hMLP limiter and calculate solution
+	hMLP_Limiter(_DOF, _solution);
+	auto solution = [&](int_t begin, int_t end) { calSolution(_DOF, _solution, begin, end); };
+	ThreadPool::parallelFor(0, num_cell, solution);
+
+	// Finished lanes keep their solution
+	bool restore = false;
+	for (int_t lane = 0; lane < W; ++lane) restore = restore || !_active[lane];
+	if (restore)
+	{
+		auto keep = [&](int_t begin, int_t end)
+		{
+			for (int_t icell = begin; icell < end; ++icell)
+			{
+				for (int_t lane = 0; lane < W; ++lane)
+				{
+					if (_active[lane]) continue;
+					for (int_t idegree = 0; idegree < num_mode; ++idegree)
+						_DOF[index(icell, idegree) + lane] = _saved_DOF[index(icell, idegree) + lane];
+					_solution[icell*W + lane] = _saved_solution[icell*W + lane];
+				}
+			}
+		};
+		ThreadPool::parallelFor(0, num_cell, keep);
+	}
+
+	// Update current time
+	for (int_t lane = 0; lane < W; ++lane)
+	{
+		if (!_active[lane]) continue;
+		_currentTime[lane] += _timeStep[lane];
+		_num_step[lane]++;
+		if (_finish[lane]) _active[lane] = false;
+	}
+
+	return true;
+}
+
+template <int_t W>
+void EnsembleWidth<W>::computeTimeStep()
+{
+	for (int_t lane = 0; lane < W; ++lane)
+	{
+		if (!_active[lane] || _finish[lane]) continue;
+		if (_PDEtype == "advection")
+			_timeStep[lane] = _CFL[lane] * _size_cell / std::abs(_speed[lane]) / double(2 * _polyOrder + 1);
+	}
+	if (_PDEtype != "burgers") return;
+
+	// Maximum speed of every lane
+	real_t maxSpeed[W];
+	for (int_t lane = 0; lane < W; ++lane) maxSpeed[lane] = 0.0;
+	for (int_t icell = 0; icell < _num_cell - 1; ++icell)
+	{
+		for (int_t lane = 0; lane < W; ++lane)
+		{
+			real_t temp_sol1 = _solution[icell*W + lane];
+			real_t temp_sol2 = _solution[(icell + 1)*W + lane];
+			real_t shockSpeed;
+			if (temp_sol1 >= temp_sol2) shockSpeed = 0.5*std::abs(temp_sol1 + temp_sol2);
+			else shockSpeed = std::max(std::abs(temp_sol1), std::abs(temp_sol2));
+			maxSpeed[lane] = std::max(maxSpeed[lane], shockSpeed);
+		}
+	}
+
+	for (int_t lane = 0; lane < W; ++lane)
+	{
+		if (!_active[lane] || _finish[lane]) continue;
+		_timeStep[lane] = _CFL[lane] * _size_cell / maxSpeed[lane] / double(2 * _polyOrder + 1);
+	}
+}
+
+template <int_t W>
+void EnsembleWidth<W>::applyBoundary(LaneArray& DOF, LaneArray& solution)
+{
+	const int_t num_cell = _num_cell;
+	for (int_t icell = 0; icell < GHOST; ++icell)
+	{
+		for (int_t lane = 0; lane < W; ++lane)
+		{
+			if (_boundary == "constant")
+			{
+				solution[icell*W + lane] = _begin[lane];
+				solution[(num_cell - 1 - icell)*W + lane] = _end[lane];
+				for (int_t idegree = 0; idegree <= _polyOrder; ++idegree)
+				{
+					DOF[index(icell, idegree) + lane] = _beginDOF[idegree*W + lane];
+					DOF[index(num_cell - 1 - icell, idegree) + lane] = _endDOF[idegree*W + lane];
+				}
+			}
+			else
+			{
+				solution[icell*W + lane] = solution[(num_cell - 2 * GHOST + icell)*W + lane];
+				solution[(num_cell - GHOST + icell)*W + lane] = solution[(icell + GHOST)*W + lane];
+				for (int_t idegree = 0; idegree <= _polyOrder; ++idegree)
+				{
+					DOF[index(icell, idegree) + lane] = DOF[index(num_cell - 2 * GHOST + icell, idegree) + lane];
+					DOF[index(num_cell - GHOST + icell, idegree) + lane] = DOF[index(icell + GHOST, idegree) + lane];
+				}
+			}
+		}
+	}
+}
+
+template <int_t W>
+void EnsembleWidth<W>::computeRHS(const LaneArray& DOF)
+{
+	const int_t num_cell = _num_cell;
+	const int_t P = _polyOrder;
+	const real_t inv_sizeX = 1.0 / _size_cell;
+	const bool advection = (_PDEtype == "advection");
+
+	// RHS of ghost cells stays zero
+	for (int_t icell = 0; icell < GHOST; ++icell)
+	{
+		std::fill(_RHS.begin() + index(icell, 0), _RHS.begin() + index(icell + 1, 0), 0.0);
+		std::fill(_RHS.begin() + index(num_cell - 1 - icell, 0), _RHS.begin() + index(num_cell - icell, 0), 0.0);
+	}
+
+	// Branchless Godunov flux, the same as vectorized single-case kernel
+	real_t upwind[W];
+	real_t downwind[W];
+	for (int_t lane = 0; lane < W; ++lane)
+	{
+		upwind[lane] = std::max(_speed[lane], 0.0);
+		downwind[lane] = std::min(_speed[lane], 0.0);
+	}
+
+	// DG flux
+	auto interfaceFlux = [&](int_t begin, int_t end)
+	{
+		for (int_t icell = begin; icell < end; ++icell)
+		{
+			// Local projection
+			real_t left_u[W];
+			real_t right_u[W];
+			for (int_t lane = 0; lane < W; ++lane) left_u[lane] = right_u[lane] = 0.0;
+			for (int_t idegree = 0; idegree <= P; ++idegree)
+			{
+				const real_t* left_DOF = &DOF[index(icell - 1, idegree)];
+				const real_t* right_DOF = &DOF[index(icell, idegree)];
+				for (int_t lane = 0; lane < W; ++lane)
+				{
+					left_u[lane] += _faceRight[idegree] * left_DOF[lane];
+					right_u[lane] += _faceLeft[idegree] * right_DOF[lane];
+				}
+			}
+
+			// Calculate flux
+			real_t* flux = &_flux[icell*W];
+			if (advection)
+			{
+				for (int_t lane = 0; lane < W; ++lane)
+					flux[lane] = upwind[lane] * left_u[lane] + downwind[lane] * right_u[lane];
+			}
+			else
+			{
+				for (int_t lane = 0; lane < W; ++lane)
+				{
+					real_t left = std::max(left_u[lane], 0.0);
+					real_t right = std::min(right_u[lane], 0.0);
+					flux[lane] = std::max(0.5*left*left, 0.5*right*right);
+				}
+			}
+		}
+	};
+	ThreadPool::parallelFor(GHOST, num_cell - GHOST + 1, interfaceFlux);
+
+	// Calculate RHS
+	auto volumeIntegral = [&](int_t begin, int_t end)
+	{
+		for (int_t icell = begin; icell < end; ++icell)
+		{
+			// Physical flux at quadrature points
+			real_t phyFlux[QuadDegree][W];
+			if (P > 0)
+			{
+				for (int_t iquad = 0; iquad < QuadDegree; ++iquad)
+				{
+					real_t u[W];
+					for (int_t lane = 0; lane < W; ++lane) u[lane] = 0.0;
+					for (int_t idegree = 0; idegree <= P; ++idegree)
+					{
+						const real_t* cell_DOF = &DOF[index(icell, idegree)];
+						for (int_t lane = 0; lane < W; ++lane)
+							u[lane] += _basisQuad[idegree*QuadDegree + iquad] * cell_DOF[lane];
+					}
+					if (advection)
+					{
+						for (int_t lane = 0; lane < W; ++lane) phyFlux[iquad][lane] = _speed[lane] * u[lane];
+					}
+					else
+					{
+						for (int_t lane = 0; lane < W; ++lane) phyFlux[iquad][lane] = 0.5*u[lane] * u[lane];
+					}
+				}
+			}
+
+			// Surface and volume integral
+			const real_t* flux_left = &_flux[icell*W];
+			const real_t* flux_right = &_flux[(icell + 1)*W];
+			for (int_t idegree = 0; idegree <= P; ++idegree)
+			{
+				real_t rhs[W];
+				for (int_t lane = 0; lane < W; ++lane)
+					rhs[lane] = _surfRight[idegree] * flux_right[lane] + _surfLeft[idegree] * flux_left[lane];
+				if (P > 0)
+				{
+					for (int_t iquad = 0; iquad < QuadDegree; ++iquad)
+					{
+						for (int_t lane = 0; lane < W; ++lane)
+							rhs[lane] += _volume[idegree*QuadDegree + iquad] * phyFlux[iquad][lane];
+					}
+				}
+				real_t* cell_RHS = &_RHS[index(icell, idegree)];
+				for (int_t lane = 0; lane < W; ++lane) cell_RHS[lane] = inv_sizeX*rhs[lane];
+			}
+		}
+	};
+	ThreadPool::parallelFor(GHOST, num_cell - GHOST, volumeIntegral);
+}
+
+template <int_t W>
+void EnsembleWidth<W>::calSolution(const LaneArray& DOF, LaneArray& solution, int_t begin, int_t end)
+{
+	for (int_t icell = begin; icell < end; ++icell)
+	{
+		real_t posX = _grid->getCell()[icell]->getPosX();
+		for (int_t lane = 0; lane < W; ++lane) solution[icell*W + lane] = 0.0;
+		for (int_t iorder = 0; iorder <= _polyOrder; ++iorder)
+		{
+			real_t coeff = _basis->getCoeff(iorder, icell);
+			real_t basis = _basis->basis(iorder, icell, posX);
+			for (int_t lane = 0; lane < W; ++lane)
+				solution[icell*W + lane] += coeff * DOF[index(icell, iorder) + lane] * basis;
+		}
+	}
+}
+
+template <int_t W>
+void EnsembleWidth<W>::hMLP_Limiter(LaneArray& DOF, LaneArray& solution)
+{
+	// No limiter if PO
+	if ((_polyOrder == 0) || (_limiterType == "none")) return;
+
+	// Current projected degree
+	std::fill(_projectDegree.begin(), _projectDegree.end(), _polyOrder);
+
+	// hMLP limiting process
+	for (int_t step = 0; step < _polyOrder; ++step)
+	{
+		// Marking troubled-cell, ghost cells are not troubled
+		auto mark = [&](int_t begin, int_t end)
+		{
+			for (int_t icell = begin; icell < end; ++icell)
+			{
+				if ((icell < GHOST) || (icell >= _num_cell - GHOST))
+					std::fill(_marker.begin() + icell*W, _marker.begin() + (icell + 1)*W, 1);
+				else troubleCellMarker(DOF, icell);
+			}
+		};
+		ThreadPool::parallelFor(0, _num_cell, mark);
+
+		// Project troubled-cell
+		auto project = [&](int_t begin, int_t end)
+		{
+			std::copy(DOF.begin() + index(begin, 0), DOF.begin() + index(end, 0), _limit_DOF.begin() + index(begin, 0));
+			for (int_t icell = begin; icell < end; ++icell)
+			{
+				for (int_t lane = 0; lane < W; ++lane)
+				{
+					if (_marker[icell*W + lane] != false) continue;
+					int_t& degree = _projectDegree[icell*W + lane];
+					if (degree >= 2)
+					{
+						_limit_DOF[index(icell, degree) + lane] = 0.0;
+						degree--;
+					}
+					else if (degree == 1)
+					{
+						_limit_DOF[index(icell, 1) + lane] = Limiter::MLP_limit_ftn(_limiterType, stencil(DOF, icell, lane))*_limit_DOF[index(icell, 1) + lane];
+					}
+					else ERROR("step degree");
+				}
+			}
+		};
+		ThreadPool::parallelFor(0, _num_cell, project);
+
+		// Update DOF
+		auto update = [&](int_t begin, int_t end)
+		{
+			std::copy(_limit_DOF.begin() + index(begin, 0), _limit_DOF.begin() + index(end, 0), DOF.begin() + index(begin, 0));
+			calSolution(DOF, solution, begin, end);
+		};
+		ThreadPool::parallelFor(0, _num_cell, update);
+	}
+
+	// Update solution
+	auto update = [&](int_t begin, int_t end) { calSolution(DOF, solution, begin, end); };
+	ThreadPool::parallelFor(0, _num_cell, update);
+}
+
+template <int_t W>
+void EnsembleWidth<W>::troubleCellMarker(const LaneArray& DOF, int_t icell)
+{
+	for (int_t lane = 0; lane < W; ++lane)
+		_marker[icell*W + lane] = Limiter::troubleCellMarker(stencil(DOF, icell, lane), _projectDegree[icell*W + lane]);
+}
+
+template <int_t W>
+LimiterStencil EnsembleWidth<W>::stencil(const LaneArray& DOF, int_t icell, int_t lane) const
+{
+	const real_t avg_prev = DOF[index(icell - 1, 0) + lane];
+	const real_t avg_next = DOF[index(icell + 1, 0) + lane];
+
+	LimiterStencil cell;
+	cell.avgQ = DOF[index(icell, 0) + lane];
+	cell.leftQ = faceSolution(DOF, icell, lane, _faceLeft);
+	cell.rightQ = faceSolution(DOF, icell, lane, _faceRight);
+	cell.slope = (_polyOrder > 0) ? _faceRight[1] * DOF[index(icell, 1) + lane] : 0.0;
+	cell.prevQ = faceSolution(DOF, icell - 1, lane, _faceRight);
+	cell.nextQ = faceSolution(DOF, icell + 1, lane, _faceLeft);
+	cell.maxLeftAvgQ = std::max(avg_prev, cell.avgQ);
+	cell.minLeftAvgQ = std::min(avg_prev, cell.avgQ);
+	cell.maxRightAvgQ = std::max(cell.avgQ, avg_next);
+	cell.minRightAvgQ = std::min(cell.avgQ, avg_next);
+	cell.size_cell = _size_cell;
+	return cell;
+}
+
+template class EnsembleWidth<4>;
+template class EnsembleWidth<8>;
\ No newline at end of file
@@ -0,0 +1,163 @@
+#pragma once
+#include "DataType.h"
+#include "Grid.h"
+#include "Zone.h"
+#include "DGbasis.h"
+#include "DOFArray.h"
+#include "InitialCondition.h"
+#include "Limiter.h"
+
+// Parameters of one ensemble member
+struct EnsembleCase
+{
+	real_t speed; /// advection speed
+	real_t amplitude; /// initial condition amplitude
+	real_t CFL;
+};
+
+// Ensemble of independent cases on one grid
+// Every array carries a batch dimension of width W innermost ([cell][mode][lane]), each lane is one case.
+// RHS, hMLP limiter and TVD-RK3 updates sweep all lanes at once, time step and termination are per lane.
+// A lane reproduces the single-case run with the same parameters, Burgers lanes to round-off(branchless Godunov flux on every interface).
+class Ensemble
+{
+public:
+	// Constructor / p.m. Equation type, limiter type, boundary condition, initial condition, target time, Grid(object), polynomial order
+	Ensemble(Type, Type, Type, Type, real_t, std::shared_ptr<Grid>, int_t);
+
+	// Destructor
+	virtual ~Ensemble();
+
+public:
+	// Functions
+	inline int_t getWidth() const { return _width; }
+
+	inline int_t getPolyOrder() const { return _polyOrder; }
+
+	inline real_t getTime(int_t lane) const { return _currentTime[lane]; }
+
+	inline int_t getNumStep(int_t lane) const { return _num_step[lane]; }
+
+	// Set cases of lanes and initialize solution / p.m. cases(lanes without case are inactive)
+	virtual void initialize(const std::vector<EnsembleCase>&) = 0;
+
+	// Advance every active lane by one time step / r.t. any lane still marching
+	virtual bool march() = 0;
+
+	// Copy solution of one lane to Zone / p.m. lane, Zone(output, same grid and order)
+	virtual void extract(int_t, std::shared_ptr<Zone>) const = 0;
+
+	// Create ensemble of batch width / p.m. width(4 or 8), Equation type, limiter type, boundary condition, initial condition, target time, Grid(object), polynomial order
+	static std::shared_ptr<Ensemble> create(int_t, Type, Type, Type, Type, real_t, std::shared_ptr<Grid>, int_t);
+
+	// Read cases file, one case per line : advection speed, amplitude, CFL / p.m. file name
+	static std::vector<EnsembleCase> readCases(const std::string&);
+
+protected:
+	// Variables
+	Type _PDEtype;
+	Type _limiterType;
+	Type _boundary;
+	Type _initial;
+	std::shared_ptr<Grid> _grid;
+	std::shared_ptr<DGbasis> _basis;
+	int_t _width;
+	int_t _polyOrder;
+	int_t _num_cell;
+	real_t _size_cell;
+	real_t _targetTime;
+	std::vector<real_t> _currentTime;
+	std::vector<int_t> _num_step;
+};
+
+template <int_t W>
+class EnsembleWidth : public Ensemble
+{
+public:
+	// Constructor / p.m. Equation type, limiter type, boundary condition, initial condition, target time, Grid(object), polynomial order
+	EnsembleWidth(Type, Type, Type, Type, real_t, std::shared_ptr<Grid>, int_t);
+
+	// Destructor
+	virtual ~EnsembleWidth() {}
+
+public:
+	// Functions
+	virtual void initialize(const std::vector<EnsembleCase>&);
+
+	virtual bool march();
+
+	virtual void extract(int_t, std::shared_ptr<Zone>) const;
+
+protected:
+	// Lane storage, [cell][mode][lane]
+	typedef std::vector<real_t, AlignedAllocator<real_t, DOF_ALIGN> > LaneArray;
+
+	// Variables
+	LaneArray _DOF; /// solution
+	LaneArray _solution; /// discrete solution of _DOF, [cell][lane]
+	LaneArray _saved_DOF; /// solution at step start, restored for finished lanes
+	LaneArray _saved_solution;
+	LaneArray _stage_DOF; /// stage solution of TVD-RK
+	LaneArray _stage_solution;
+	LaneArray _prev_DOF;
+	LaneArray _temp_DOF[2];
+	LaneArray _RHS;
+	LaneArray _flux; /// interface flux, [cell][lane]
+	LaneArray _limit_DOF; /// limiter work storage
+	std::vector<int_t> _projectDegree; /// [cell][lane]
+	std::vector<int_t> _marker; /// [cell][lane]
+
+	// Per lane parameters and state
+	real_t _speed[W];
+	real_t _CFL[W];
+	real_t _timeStep[W];
+	bool _active[W]; /// still marching
+	bool _finish[W]; /// last step of lane
+	real_t _begin[W];
+	real_t _end[W];
+	std::vector<real_t> _beginDOF; /// [mode][lane]
+	std::vector<real_t> _endDOF;
+
+	// RHS reference tables (same as RHSKernelOrder)
+	std::vector<real_t> _faceLeft;
+	std::vector<real_t> _faceRight;
+	std::vector<real_t> _basisQuad; /// [degree][QuadDegree]
+	std::vector<real_t> _surfLeft;
+	std::vector<real_t> _surfRight;
+	std::vector<real_t> _volume; /// [degree][QuadDegree]
+
+protected:
+	// Functions
+	// Offset of lane 0 / p.m. cell index, mode
+	inline int_t index(int_t icell, int_t imode) const { return (icell*(_polyOrder + 1) + imode)*W; }
+
+	// Apply boundary condition / p.m. DOF, discrete solution
+	void applyBoundary(LaneArray&, LaneArray&);
+
+	// Compute RHS of every lane / p.m. DOF
+	void computeRHS(const LaneArray&);
+
+	// Compute time step of active lanes
+	void computeTimeStep();
+
+	// Calculate discrete solution in cell range / p.m. DOF, discrete solution(output), begin cell, end cell(exclusive)
+	void calSolution(const LaneArray&, LaneArray&, int_t, int_t);
+
+	// hMLP limiter of every lane / p.m. DOF, discrete solution
+	void hMLP_Limiter(LaneArray&, LaneArray&);
+
+	// Troubled-cell marker of one cell, every lane / p.m. DOF, cell index
+	void troubleCellMarker(const LaneArray&, int_t);
+
+	// Limiter stencil of one cell and lane, the face traces of Limiter from the RHS face tables / p.m. DOF, cell index, lane
+	LimiterStencil stencil(const LaneArray&, int_t, int_t) const;
+
+	// Solution of one lane at a face / p.m. DOF, cell index, lane, face table(_faceLeft or _faceRight)
+	inline real_t faceSolution(const LaneArray& DOF, int_t icell, int_t lane, const std::vector<real_t>& face) const
+	{
+		real_t u = 0.0;
+		for (int_t idegree = 0; idegree <= _polyOrder; ++idegree)
+			u += face[idegree] * DOF[index(icell, idegree) + lane];
+		return u;
+	}
+};
\ No newline at end of file
@@ -0,0 +1,66 @@
+#pragma once
+#include "DataType.h"
+#include "ConvPhyFlux.h"
+
+// PDE traits
+// Physical flux and characteristic speed resolved at compile time
+struct Advection
+{
+	// Physical flux / p.m. solution variable
+	static inline real_t flux(real_t u) { return ConvPhyFlux::advection(u); }
+
+	// Characteristic speed / p.m. solution variable
+	static inline real_t charSpeed(real_t) { return ConvPhyFlux::getAdvSpeed(); }
+};
+
+struct Burgers
+{
+	// Physical flux / p.m. solution variable
+	static inline real_t flux(real_t u) { return ConvPhyFlux::burgers(u); }
+
+	// Characteristic speed / p.m. solution variable
+	static inline real_t charSpeed(real_t u) { return ConvPhyFlux::burgersChar(u); }
+};
+
+// Numerical flux functors / p.m. begin, end
+template <typename PDE>
+struct GodunovFlux;
+
+template <>
+struct GodunovFlux<Advection>
+{
+	static inline real_t compute(real_t begin, real_t end)
+	{
+		if (GET_SPEED > 0.0) return Advection::flux(begin);
+		else return Advection::flux(end);
+	}
+
+	inline real_t operator()(real_t begin, real_t end) const { return compute(begin, end); }
+};
+
+template <>
+struct GodunovFlux<Burgers>
+{
+	static inline real_t compute(real_t begin, real_t end)
+	{
+		// Shock
+		if ((begin - end) > epsilon)
+		{
+			real_t speed = 0.5*(begin + end);
+			if (speed >= 0.0) return Burgers::flux(begin);
+			else return Burgers::flux(end);
+		}
+
+		// Expansion
+		if ((begin - end) < -epsilon)
+		{
+			if (begin > 0.0) return Burgers::flux(begin);
+			else if (end < 0.0) return Burgers::flux(end);
+			else return 0.0;
+		}
+
+		else return Burgers::flux(begin);
+	}
+
+	inline real_t operator()(real_t begin, real_t end) const { return compute(begin, end); }
+};
\ No newline at end of file
@@ -1,28 +1,152 @@
 #include "Grid.h"
+#include "Decomposition.h"
 
 Grid::Grid(real_t area, real_t sizeX)
 {
 	_area = area;
 	_sizeX = sizeX;
-	_num_cell = area / sizeX;
-	_num_cell += 2 * GHOST;
+	_minSizeX = sizeX;
+	_uniform = true;
+	_num_global = area / sizeX;
+	build(0, _num_global, false, false);
+}
+
+Grid::Grid(real_t area, real_t sizeX, int_t rank, int_t size)
+{
+	_area = area;
+	_sizeX = sizeX;
+	_minSizeX = sizeX;
+	_uniform = true;
+	_num_global = area / sizeX;
+
+	int_t begin, num;
+	Decomposition::partition(_num_global, rank, size, begin, num);
+	build(begin, num, rank > 0, rank < size - 1);
+}
+
+Grid::Grid(const std::vector<real_t>& node, int_t rank, int_t size)
+{
+	if (node.size() < 2) ERROR("grid needs at least two nodes");
+	_node = node;
+	_area = node.back() - node.front();
+	_num_global = node.size() - 1;
+	_uniform = false;
+	_minSizeX = _area;
+	for (int_t icell = 0; icell < _num_global; ++icell)
+	{
+		if (node[icell + 1] <= node[icell]) ERROR("grid nodes must increase");
+		_minSizeX = std::min(_minSizeX, node[icell + 1] - node[icell]);
+	}
+	_sizeX = _minSizeX;
+
+	int_t begin, num;
+	Decomposition::partition(_num_global, rank, size, begin, num);
+	build(begin, num, rank > 0, rank < size - 1);
+}
+
+Grid::~Grid()
+{
+
+}
+
+void Grid::globalCell(int_t index, real_t& center, real_t& size) const
+{
+	if (_uniform)
+	{
+		center = -0.5*_area + _sizeX*(0.5 + index);
+		size = _sizeX;
+		return;
+	}
+
+	// Outside the domain : size of the end cell
+	int_t clamped = std::min(std::max(index, int_t(0)), _num_global - 1);
+	size = _node[clamped + 1] - _node[clamped];
+	center = 0.5*(_node[clamped] + _node[clamped + 1]);
+}
+
+void Grid::build(int_t begin, int_t num, bool leftInterface, bool rightInterface)
+{
+	_offset = begin;
+	_num_cell = num + 2 * GHOST;
 	_cell.resize(_num_cell);
+	_size.resize(_num_cell);
+	_inv_size.resize(_num_cell);
+
+	// Ghost cells of domain ends are placed at 0, ghost cells of rank interfaces at their global position
+	real_t coord, size;
 	for (int_t icell = 0; icell < GHOST; ++icell)
 	{
 		_cell[icell] = std::make_shared<Cell>();
-		_cell[_num_cell - icell - 1] = std::make_shared<Cell>();
-		_cell[icell]->initialize(false, sizeX, 0.0);
-		_cell[_num_cell - icell - 1]->initialize(false, sizeX, 0.0);
+		globalCell(begin - GHOST + icell, coord, size);
+		_cell[icell]->initialize(false, size, leftInterface ? coord : 0.0);
+
+		_cell[_num_cell - GHOST + icell] = std::make_shared<Cell>();
+		globalCell(begin + num + icell, coord, size);
+		_cell[_num_cell - GHOST + icell]->initialize(false, size, rightInterface ? coord : 0.0);
 	}
 	for (int_t icell = GHOST; icell < _num_cell - GHOST; ++icell)
 	{
-		real_t coord_X = -0.5*_area + sizeX*(0.5 + (icell - GHOST));
 		_cell[icell] = std::make_shared<Cell>();
-		_cell[icell]->initialize(true, sizeX, coord_X);
+		globalCell(begin + icell - GHOST, coord, size);
+		_cell[icell]->initialize(true, size, coord);
+	}
+
+	for (int_t icell = 0; icell < _num_cell; ++icell)
+	{
+		_size[icell] = _cell[icell]->getSizeX();
+		_inv_size[icell] = 1.0 / _size[icell];
 	}
 }
 
-Grid::~Grid()
+std::vector<real_t> Grid::makeNode(Type type, real_t area, real_t sizeX, const std::vector<real_t>& parameter, const std::string& fileName)
 {
+	std::vector<real_t> node;
+	const int_t num_uniform = area / sizeX;
+
+	if (type == "stretched")
+	{
+		// Geometric sizes dX0*r^i over the cells of the uniform grid
+		if (parameter.size() != 1 || (parameter[0] <= 0.0)) ERROR("grid stretching ratio");
+		const real_t ratio = parameter[0];
+		std::vector<real_t> size(num_uniform);
+		real_t sum = 0.0;
+		for (int_t icell = 0; icell < num_uniform; ++icell)
+		{
+			size[icell] = pow(ratio, icell);
+			sum += size[icell];
+		}
+		node.push_back(-0.5*area);
+		for (int_t icell = 0; icell < num_uniform; ++icell) node.push_back(node.back() + area*size[icell] / sum);
+		node.back() = 0.5*area;
+	}
+
+	else if (type == "clustered")
+	{
+		// Uniform pieces : [-area/2, begin], [begin, end] refined by factor, [end, area/2]
+		if (parameter.size() != 3) ERROR("grid cluster needs begin, end, factor");
+		const real_t piece[4] = { -0.5*area, parameter[0], parameter[1], 0.5*area };
+		const real_t factor = parameter[2];
+		if (!((piece[0] < piece[1]) && (piece[1] < piece[2]) && (piece[2] < piece[3])) || (factor <= 0.0)) ERROR("grid cluster");
+		node.push_back(piece[0]);
+		for (int_t ipiece = 0; ipiece < 3; ++ipiece)
+		{
+			const real_t length = piece[ipiece + 1] - piece[ipiece];
+			const real_t size = (ipiece == 1) ? sizeX / factor : sizeX;
+			const int_t num = std::max(int_t(1), int_t(length / size + 0.5));
+			for (int_t icell = 1; icell < num; ++icell) node.push_back(piece[ipiece] + length*icell / num);
+			node.push_back(piece[ipiece + 1]);
+		}
+	}
+
+	else if (type == "file")
+	{
+		std::ifstream file(fileName);
+		if (!file.is_open()) ERROR("cannot open grid file");
+		real_t coord;
+		while (file >> coord) node.push_back(coord);
+	}
+
+	else ERROR("cannot find grid type");
 
+	return node;
 }
\ No newline at end of file
@@ -2,12 +2,23 @@
 #include "DataType.h"
 #include "Cell.h"
 
+// One-dimensional grid of real cells and GHOST layers on both ends
+// Uniform grid : cells of size dX on [-area/2, area/2].
+// Non-uniform grid : cells between given node coordinates, every cell keeps its own size.
+// Ghost cells of domain ends are placed at 0 with the size of the adjacent real cell,
+// ghost cells of rank interfaces take position and size of the neighbor's cells.
 class Grid
 {
 public:
 	// Constructor / p.m. area, size dX
 	Grid(real_t, real_t);
 
+	// Constructor of rank-local slab / p.m. area, size dX, rank, number of ranks
+	Grid(real_t, real_t, int_t, int_t);
+
+	// Constructor of non-uniform grid / p.m. node coordinates(increasing), rank, number of ranks
+	Grid(const std::vector<real_t>&, int_t, int_t);
+
 	// Destructor
 	~Grid();
 
@@ -15,18 +26,52 @@ public:
 	// Functions
 	inline int_t getNumCell() const { return _num_cell; }
 
+	// Global index of first real cell and number of global real cells
+	inline int_t getOffset() const { return _offset; }
+
+	inline int_t getNumGlobalCell() const { return _num_global; }
+
 	inline real_t getArea() const { return _area; }
 
-	inline real_t getSizeX() const { return _sizeX; }
+	// Smallest real cell of the whole domain
+	inline real_t getMinSizeX() const { return _minSizeX; }
+
+	inline bool isUniform() const { return _uniform; }
+
+	// Size and inverse size of every cell, contiguous for kernels
+	inline const std::vector<real_t>& getSizeX() const { return _size; }
 
-	inline std::vector<std::shared_ptr<Cell> > getCell() const { return _cell; }
+	inline const std::vector<real_t>& getInvSizeX() const { return _inv_size; }
+
+	inline const std::vector<std::shared_ptr<Cell> >& getCell() const { return _cell; }
 
 	inline void setCell(std::vector<std::shared_ptr<Cell>> cell) { _cell = cell; }
 
+	// Node coordinates of grid type / p.m. grid type(uniform, stretched, clustered, file), area, size dX, parameters, node file
+	// stretched : parameter = { ratio of neighboring cells }, number of cells of the uniform grid
+	// clustered : parameter = { begin, end, refinement factor }, cells of size dX/factor inside [begin, end], dX outside
+	// file : node coordinates, one per line
+	static std::vector<real_t> makeNode(Type, real_t, real_t, const std::vector<real_t>&, const std::string&);
+
 protected:
 	// Variables
 	int_t _num_cell;
+	int_t _num_global;
+	int_t _offset;
 	real_t _area;
-	real_t _sizeX;
+	real_t _sizeX; /// cell size of uniform grid
+	real_t _minSizeX;
+	bool _uniform;
+	std::vector<real_t> _node; /// global node coordinates of non-uniform grid
+	std::vector<real_t> _size;
+	std::vector<real_t> _inv_size;
 	std::vector<std::shared_ptr<Cell> > _cell;
+
+protected:
+	// Functions
+	// Build cells of slab / p.m. first global real cell, number of real cells, left ghosts are rank interface, right ghosts are rank interface
+	void build(int_t, int_t, bool, bool);
+
+	// Center and size of global cell, clamped to real cells for size / p.m. global cell index, center(output), size(output)
+	void globalCell(int_t, real_t&, real_t&) const;
 };
\ No newline at end of file
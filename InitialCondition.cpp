@@ -3,6 +3,13 @@
 InitialCondition::InitialCondition(Type type)
 {
 	_type = type;
+	_amplitude = 1.0;
+}
+
+InitialCondition::InitialCondition(Type type, real_t amplitude)
+{
+	_type = type;
+	_amplitude = amplitude;
 }
 
 InitialCondition::~InitialCondition()
@@ -11,6 +18,11 @@ InitialCondition::~InitialCondition()
 }
 
 real_t InitialCondition::initializer(real_t x) const
+{
+	return _amplitude*shape(x);
+}
+
+real_t InitialCondition::shape(real_t x) const
 {
 	if (_type == "square")
 		return square(x);
@@ -7,6 +7,9 @@ public:
 	// Constructor / p.m. initial condition type
 	InitialCondition(Type);
 
+	// Constructor / p.m. initial condition type, amplitude
+	InitialCondition(Type, real_t);
+
 	// Destructor
 	~InitialCondition();
 
@@ -14,15 +17,21 @@ public:
 	// Functions
 	inline Type getType() { return _type; }
 
+	inline real_t getAmplitude() const { return _amplitude; }
+
 	// calculate initial condition
 	real_t initializer(real_t) const;
 
 protected:
 	// Variables
 	Type _type;
+	real_t _amplitude;
 
 protected:
 	// Functions
+	// Initial condition without amplitude / p.m. x coordinate
+	real_t shape(real_t) const;
+
 	// Initial condition functions
 	real_t square(real_t) const;
 	real_t halfdome(real_t) const;
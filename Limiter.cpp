@@ -1,11 +1,33 @@
 #include "Limiter.h"
+#include "Decomposition.h"
+#include "Timer.h"
 
 Limiter::Limiter(Type limiter, std::shared_ptr<Zone> zone)
 {
 	_limiter = limiter;
 	_polyOrder = zone->getPolyOrder();
 	_num_cell = zone->getGrid()->getNumCell();
-	_size_cell = zone->getGrid()->getSizeX();
+
+	// Work storage
+	_projectDegree.resize(_num_cell);
+	_marker.resize(_num_cell);
+	_leftQ.resize(_num_cell);
+	_rightQ.resize(_num_cell);
+	_slope.resize(_num_cell);
+	_maxAvgQ.resize(_num_cell);
+	_minAvgQ.resize(_num_cell);
+	_candidate.reserve(_num_cell); /// lists of cells never grow while limiting
+	_troubled.reserve(_num_cell);
+
+	// Basis function times its coefficient on faces is (2n+1)/scale*Legendre(-1 or 1)
+	_faceLeft.resize(_polyOrder + 1);
+	_faceRight.resize(_polyOrder + 1);
+	for (int_t idegree = 0; idegree <= _polyOrder; ++idegree)
+	{
+		real_t sign = (idegree % 2 == 0) ? 1.0 : -1.0;
+		_faceLeft[idegree] = sign*(2 * idegree + 1) / DGbasis::legendreScale(idegree);
+		_faceRight[idegree] = (2 * idegree + 1) / DGbasis::legendreScale(idegree);
+	}
 }
 
 Limiter::~Limiter()
@@ -15,221 +37,345 @@ Limiter::~Limiter()
 
 void Limiter::hMLP_Limiter(std::shared_ptr<Zone> zone)
 {
+	TIMER_SCOPE(Phase::Limiter);
+
+	// No limiter if PO
+	if ((_polyOrder == 0) || (_limiter == "none")) return;
+
+	// Nodal DOF are limited as modal DOF
+	const bool nodal = zone->isNodal();
+	if (nodal) zone->setNodal(false);
+	hMLP_Limiter(zone, 0, _num_cell);
+	if (nodal) zone->setNodal(true);
+
+	// Ghost cells of rank interfaces take the neighbor's limited DOF and solution
+	Decomposition::exchange(zone);
+}
+
+void Limiter::hMLP_Limiter(std::shared_ptr<Zone> zone, int_t begin, int_t end)
+{
+	TIMER_SCOPE(Phase::Limiter);
+
 	// No limiter if PO
 	if ((_polyOrder == 0) || (_limiter == "none")) return;
 
 	// Temporary variables for hMLP
 	// Current projected degree
-	std::vector<int_t> projectDegree(_num_cell, _polyOrder);
+	std::vector<int_t>& projectDegree = _projectDegree;
+	std::fill(projectDegree.begin() + begin, projectDegree.begin() + end, _polyOrder);
+
+	// Real cells of the range, ghost cells are not troubled
+	const int_t first = std::max(begin, int_t(GHOST));
+	const int_t last = std::min(end, _num_cell - GHOST);
+	const bool multiRank = (Decomposition::getSize() > 1);
+
+	// Cells to mark, every real cell at the screening step
+	std::vector<int_t>& candidate = _candidate;
+	std::vector<int_t>& troubled = _troubled;
+	candidate.clear();
+	for (int_t icell = first; icell < last; ++icell)
+		candidate.push_back(icell);
 
 	// hMLP limiting process
 	for (int_t step = 0; step < _polyOrder; ++step)
 	{
-		// Troubled-cell marker
-		std::vector<bool> marker(_num_cell, true);
+		// Ghost cells of rank interfaces take the neighbor's current DOF
+		Decomposition::exchange(zone);
 
-		// Marking troubled-cell
-		for (int_t icell = GHOST; icell < _num_cell - GHOST; ++icell)
+		// Face traces of the range at the screening step, then kept by the projection
+		// Ghost cells of rank interfaces may change every step, cells next to them are marked again
+		if (step == 0) computeTrace(zone, begin, end);
+		else if (multiRank)
 		{
-			marker[icell] = troubleCellMarker(zone, projectDegree[icell], icell);
+			computeTrace(zone, 0, GHOST);
+			computeTrace(zone, _num_cell - GHOST, _num_cell);
+			if ((first == GHOST) && (candidate.empty() || (candidate.front() != first))) candidate.insert(candidate.begin(), first);
+			if ((last == _num_cell - GHOST) && (candidate.empty() || (candidate.back() != last - 1))) candidate.push_back(last - 1);
 		}
 
+		// Troubled-cell marker of candidates
+		std::vector<int_t>& marker = _marker;
+		auto mark = [&](int_t begin, int_t end)
+		{
+			for (int_t index = begin; index < end; ++index)
+				marker[index] = troubleCellMarker(stencil(zone, candidate[index]), projectDegree[candidate[index]]);
+		};
+		ThreadPool::parallelFor(0, int_t(candidate.size()), mark);
+
+		// Compact list of troubled cells
+		troubled.clear();
+		for (size_t index = 0; index < candidate.size(); ++index)
+			if (marker[index] == false) troubled.push_back(candidate[index]);
+
 		// Project troubled-cell
-		troubleCellProject(zone, projectDegree, marker);
-	}
+		troubleCellProject(zone, projectDegree, troubled);
 
-	// Update zone
-	zone->calSolution();
+		// Markers of other cells are unchanged, troubled cells and their neighbors are marked at next step
+		candidate.clear();
+		for (int_t icell : troubled)
+		{
+			for (int_t jcell = std::max(icell - 1, first); jcell <= std::min(icell + 1, last - 1); ++jcell)
+				if (candidate.empty() || (candidate.back() < jcell)) candidate.push_back(jcell);
+		}
+		if (candidate.empty() && !multiRank) break;
+	}
 }
 
-void Limiter::troubleCellProject
-(std::shared_ptr<Zone> zone, std::vector<int_t>& degree, const std::vector<bool>& marker)
+void Limiter::troubleCellProject(std::shared_ptr<Zone> zone, std::vector<int_t>& degree, const std::vector<int_t>& troubled)
 {
-	// Temporary DOF and Zone
-	std::vector<std::vector<real_t> > temp_DOF = zone->getDOF();
+	DOFArray& DOF = zone->getDOF();
 
-	// Projection
-	for (int_t icell = 0; icell < _num_cell; ++icell)
+	// Projection in place, markers and MLP limiter of this step read the face trace cache only
+	auto project = [&](int_t begin, int_t end)
 	{
-		if (marker[icell] == false)
+		for (int_t index = begin; index < end; ++index)
 		{
+			const int_t icell = troubled[index];
 			if (degree[icell] > 2)
 			{
-				temp_DOF[degree[icell]][icell] = 0.0;
+				DOF(degree[icell], icell) = 0.0;
 				degree[icell]--;
 			}
 			else if (degree[icell] == 2)
 			{
-				temp_DOF[2][icell] = 0.0;
+				DOF(2, icell) = 0.0;
 				degree[icell]--;
 			}
 			else if (degree[icell] == 1)
 			{
-				temp_DOF[1][icell] = MLP_limit_ftn(zone, icell)*temp_DOF[1][icell];
+				DOF(1, icell) = MLP_limit_ftn(_limiter, stencil(zone, icell))*DOF(1, icell);
 			}
 			else ERROR("step degree");
-		}
-	}
 
-	// Update zone
-	zone->setDOF(temp_DOF);
-	zone->calSolution();
+			// Update face traces and solution of the cell
+			traceCell(DOF, icell);
+			zone->calSolution(icell, icell + 1);
+		}
+	};
+	ThreadPool::parallelFor(0, int_t(troubled.size()), project);
 }
 
-bool Limiter::troubleCellMarker(std::shared_ptr<Zone> zone, int_t degree, int_t icell) const
+bool Limiter::troubleCellMarker(const LimiterStencil& cell, int_t degree)
 {
-	bool marker = augmentMLPmarker(zone, icell);
-	if ((marker == false) && (degree > 1)) marker = extremaDetector(zone, icell);
+	bool marker = augmentMLPmarker(cell);
+	if ((marker == false) && (degree > 1)) marker = extremaDetector(cell);
 	
 	return marker;
 }
 
-bool Limiter::augmentMLPmarker(std::shared_ptr<Zone> zone, int_t icell) const
+void Limiter::adaptDegree(std::shared_ptr<Zone> zone)
 {
-	// Augmented MLP condition marker
-	bool marker = true;
+	if (!zone->isAdaptiveOrder() || (_polyOrder == 0) || (_limiter == "none")) return;
+	TIMER_SCOPE(Phase::Limiter);
+
+	// New order in work storage, neighbors are read while cells change
+	std::vector<int_t>& degree = zone->getDegree();
+	std::vector<int_t>& newDegree = _marker;
+	// Face traces are current after the limiter, ghost cells of rank interfaces took the neighbor's limited DOF
+	if (Decomposition::getSize() > 1)
+	{
+		computeTrace(zone, 0, GHOST);
+		computeTrace(zone, _num_cell - GHOST, _num_cell);
+	}
+
+	// Jumps on faces of smooth solutions vanish faster than sqrt(cell size), jumps of discontinuities stay
+	// Cells of constant stencils have nothing to resolve and stay reduced
+	auto smooth = [&](int_t icell)
+	{
+		real_t size_cell = zone->getGrid()->getSizeX()[icell];
+		real_t leftJump = std::abs(_leftQ[icell] - _rightQ[icell - 1]);
+		real_t rightJump = std::abs(_rightQ[icell] - _leftQ[icell + 1]);
+		real_t jump = std::max(leftJump, rightJump);
+		return (jump > 0.0) && (jump <= std::max(0.001*std::abs(zone->getDOF()(0, icell)), sqrt(size_cell)));
+	};
+	auto adapt = [&](int_t begin, int_t end)
+	{
+		for (int_t icell = begin; icell < end; ++icell)
+		{
+			// Projected cells keep their degree, MLP limiting to zero slope leaves P0
+			int_t project = _projectDegree[icell];
+			if ((project == 1) && (zone->getDOF()(1, icell) == 0.0)) project = 0;
+			newDegree[icell] = degree[icell];
+			if ((degree[icell] > 0) && (project < _polyOrder)) newDegree[icell] = project;
+
+			// Reduced cells return to full order without jumps on their faces, P0 cells have no slope to limit
+			else if ((degree[icell] < _polyOrder) && smooth(icell)) newDegree[icell] = _polyOrder;
+		}
+	};
+	ThreadPool::parallelFor(GHOST, _num_cell - GHOST, adapt);
 
-	// Temporary DOF
-	std::vector<std::vector<real_t> > temp_DOF = zone->getDOF();
+	auto update = [&](int_t begin, int_t end) { std::copy(newDegree.begin() + begin, newDegree.begin() + end, degree.begin() + begin); };
+	ThreadPool::parallelFor(GHOST, _num_cell - GHOST, update);
+}
 
-	// Variables
-	real_t coord_x_left = zone->getGrid()->getCell()[icell]->getPosX() - 0.5*_size_cell;
-	real_t coord_x_right = zone->getGrid()->getCell()[icell]->getPosX() + 0.5*_size_cell;
+bool Limiter::isTroubled(std::shared_ptr<Zone> zone, int_t icell) const
+{
+	const LimiterStencil cell = stencil(zone, icell);
+
+	// Deactivation threshold of extremaDetector on the stencil
+	real_t max_Q = std::max(std::max(cell.maxLeftAvgQ, cell.maxRightAvgQ), std::max(cell.leftQ, cell.rightQ));
+	real_t min_Q = std::min(std::min(cell.minLeftAvgQ, cell.minRightAvgQ), std::min(cell.leftQ, cell.rightQ));
+	real_t threshold = std::max(0.001*cell.avgQ, cell.size_cell);
+	if (max_Q - min_Q <= threshold) return false;
+
+	// Discontinuity on a face, cells on both sides may pass the marker
+	real_t leftJump = std::abs(cell.leftQ - cell.prevQ);
+	real_t rightJump = std::abs(cell.rightQ - cell.nextQ);
+	if (std::max(leftJump, rightJump) > threshold) return true;
+
+	return !troubleCellMarker(cell, _polyOrder);
+}
+
+void Limiter::computeTrace(std::shared_ptr<Zone> zone, int_t begin, int_t end)
+{
+	const DOFArray& DOF = zone->getDOF();
+
+	// One sweep over the range and its neighbors, face bounds need the left neighbor
+	auto trace = [&](int_t begin, int_t end)
+	{
+		for (int_t icell = begin; icell < end; ++icell)
+		{
+			traceCell(DOF, icell);
+			if (icell == 0) continue;
+			_maxAvgQ[icell] = std::max(DOF(0, icell - 1), DOF(0, icell));
+			_minAvgQ[icell] = std::min(DOF(0, icell - 1), DOF(0, icell));
+		}
+	};
+	ThreadPool::parallelFor(std::max(begin - 1, int_t(0)), std::min(end + 1, _num_cell), trace);
+}
+
+void Limiter::traceCell(const DOFArray& DOF, int_t icell)
+{
+	real_t left = 0.0;
+	real_t right = 0.0;
+	for (int_t idegree = 0; idegree <= _polyOrder; ++idegree)
+	{
+		left += _faceLeft[idegree] * DOF(idegree, icell);
+		right += _faceRight[idegree] * DOF(idegree, icell);
+	}
+	_leftQ[icell] = left;
+	_rightQ[icell] = right;
+	_slope[icell] = (_polyOrder > 0) ? _faceRight[1] * DOF(1, icell) : 0.0;
+}
+
+LimiterStencil Limiter::stencil(std::shared_ptr<Zone> zone, int_t icell) const
+{
+	LimiterStencil cell;
+	cell.avgQ = zone->getDOF()(0, icell);
+	cell.leftQ = _leftQ[icell];
+	cell.rightQ = _rightQ[icell];
+	cell.slope = _slope[icell];
+	cell.prevQ = _rightQ[icell - 1];
+	cell.nextQ = _leftQ[icell + 1];
+	cell.maxLeftAvgQ = _maxAvgQ[icell];
+	cell.minLeftAvgQ = _minAvgQ[icell];
+	cell.maxRightAvgQ = _maxAvgQ[icell + 1];
+	cell.minRightAvgQ = _minAvgQ[icell + 1];
+	cell.size_cell = zone->getGrid()->getSizeX()[icell];
+	return cell;
+}
+
+bool Limiter::augmentMLPmarker(const LimiterStencil& cell)
+{
+	// Augmented MLP condition marker
+	bool marker = true;
 
 	// Variables to MLP condition
-	real_t max_avgQ; /// maximum averaged Q
-	real_t min_avgQ; /// minimum averaged Q
 	real_t max_appQ; /// maximum approximated Q
 	real_t min_appQ; /// minimum approximated Q
-	real_t appQ; /// approximated vertex Q
 
 	// Left cell MLP condition
-	appQ = zone->getPolySolution(icell, coord_x_left);
-	max_appQ = std::max(zone->getPolySolution(icell - 1, coord_x_left), zone->getPolySolution(icell, coord_x_left));
-	min_appQ = std::min(zone->getPolySolution(icell - 1, coord_x_left), zone->getPolySolution(icell, coord_x_left));
-	max_avgQ = std::max(zone->getDOF()[0][icell - 1], zone->getDOF()[0][icell]);
-	min_avgQ = std::min(zone->getDOF()[0][icell - 1], zone->getDOF()[0][icell]);
-	if (!((max_avgQ > max_appQ) && (min_appQ > min_avgQ)))
+	max_appQ = std::max(cell.prevQ, cell.leftQ);
+	min_appQ = std::min(cell.prevQ, cell.leftQ);
+	if (!((cell.maxLeftAvgQ > max_appQ) && (min_appQ > cell.minLeftAvgQ)))
 		marker = false;
 
 	// Right cell MLP condition
-	appQ = zone->getPolySolution(icell, coord_x_right);
-	max_appQ = std::max(zone->getPolySolution(icell, coord_x_right), zone->getPolySolution(icell + 1, coord_x_right));
-	min_appQ = std::min(zone->getPolySolution(icell, coord_x_right), zone->getPolySolution(icell + 1, coord_x_right));
-	max_avgQ = std::max(zone->getDOF()[0][icell], zone->getDOF()[0][icell + 1]);
-	min_avgQ = std::min(zone->getDOF()[0][icell], zone->getDOF()[0][icell + 1]);
-	if (!((max_avgQ > max_appQ) && (min_appQ > min_avgQ)))
+	max_appQ = std::max(cell.rightQ, cell.nextQ);
+	min_appQ = std::min(cell.rightQ, cell.nextQ);
+	if (!((cell.maxRightAvgQ > max_appQ) && (min_appQ > cell.minRightAvgQ)))
 		marker = false;
 
 	return marker;
 }
 
-bool Limiter::extremaDetector(std::shared_ptr<Zone> zone, int_t icell) const
+bool Limiter::extremaDetector(const LimiterStencil& cell)
 {
 	// Decomposing the DG-Pn approximation
-	real_t avgQ = zone->getDOF()[0][icell];
-	real_t max_avgQ;
-	real_t min_avgQ;
+	real_t avgQ = cell.avgQ;
 	real_t P1_projected;
 	real_t Pn_projected_slope;
 	real_t P1_filtered_Pn;
-	
-	real_t coord_x_left = zone->getGrid()->getCell()[icell]->getPosX() - 0.5*_size_cell;
-	real_t coord_x_right = zone->getGrid()->getCell()[icell]->getPosX() + 0.5*_size_cell;
 
-	real_t leftQ = zone->getPolySolution(icell, coord_x_left);
-	real_t rightQ = zone->getPolySolution(icell, coord_x_right);
+	real_t leftQ = cell.leftQ;
+	real_t rightQ = cell.rightQ;
 
 	// Deactivation threshold
-	real_t threshold = std::max(0.001*avgQ, _size_cell);
-	if ((abs(leftQ - avgQ) <= threshold) && (abs(rightQ - avgQ) <= threshold))
+	real_t threshold = std::max(0.001*avgQ, cell.size_cell);
+	if ((std::abs(leftQ - avgQ) <= threshold) && (std::abs(rightQ - avgQ) <= threshold))
 		return true; /// deactivation
 
 	// Left vertex
 	bool leftMarker = false;
-	P1_projected = projectionTo(1, zone, icell, coord_x_left);
-	Pn_projected_slope = P1_projected - avgQ;
-	P1_filtered_Pn = zone->getPolySolution(icell, coord_x_left) - P1_projected;
-	max_avgQ = std::max(zone->getDOF()[0][icell - 1], zone->getDOF()[0][icell]);
-	min_avgQ = std::min(zone->getDOF()[0][icell - 1], zone->getDOF()[0][icell]);
-	
+	Pn_projected_slope = -cell.slope;
+	P1_projected = avgQ + Pn_projected_slope;
+	P1_filtered_Pn = leftQ - P1_projected;
+
 	// Marking
-	if ((Pn_projected_slope > 0.0) && (P1_filtered_Pn < 0.0) && (leftQ > min_avgQ)) leftMarker = true;
-	if ((Pn_projected_slope < 0.0) && (P1_filtered_Pn > 0.0) && (leftQ < max_avgQ)) leftMarker = true;
+	if ((Pn_projected_slope > 0.0) && (P1_filtered_Pn < 0.0) && (leftQ > cell.minLeftAvgQ)) leftMarker = true;
+	if ((Pn_projected_slope < 0.0) && (P1_filtered_Pn > 0.0) && (leftQ < cell.maxLeftAvgQ)) leftMarker = true;
 
 	// Right vertex
 	bool rightMarker = false;
-	P1_projected = projectionTo(1, zone, icell, coord_x_right);
-	Pn_projected_slope = P1_projected - avgQ;
-	P1_filtered_Pn = zone->getPolySolution(icell, coord_x_right) - P1_projected;
-	max_avgQ = std::max(zone->getDOF()[0][icell], zone->getDOF()[0][icell + 1]);
-	min_avgQ = std::min(zone->getDOF()[0][icell], zone->getDOF()[0][icell + 1]);
+	Pn_projected_slope = cell.slope;
+	P1_projected = avgQ + Pn_projected_slope;
+	P1_filtered_Pn = rightQ - P1_projected;
 
 	// Marking
-	if ((Pn_projected_slope > 0.0) && (P1_filtered_Pn < 0.0) && (rightQ > min_avgQ)) rightMarker = true;
-	if ((Pn_projected_slope < 0.0) && (P1_filtered_Pn > 0.0) && (rightQ < max_avgQ)) rightMarker = true;
+	if ((Pn_projected_slope > 0.0) && (P1_filtered_Pn < 0.0) && (rightQ > cell.minRightAvgQ)) rightMarker = true;
+	if ((Pn_projected_slope < 0.0) && (P1_filtered_Pn > 0.0) && (rightQ < cell.maxRightAvgQ)) rightMarker = true;
 
 	// Smooth extrema detect
 	return (leftMarker && rightMarker);
 }
 
-real_t Limiter::MLP_limit_ftn(std::shared_ptr<Zone> zone, int_t icell) const
+real_t Limiter::MLP_limit_ftn(const Type& limiter, const LimiterStencil& cell)
 {
 	// Variables
 	real_t limit_ftn_left;
 	real_t limit_ftn_right;
-	real_t coord_x_left = zone->getGrid()->getCell()[icell]->getPosX() - 0.5*_size_cell;
-	real_t coord_x_right = zone->getGrid()->getCell()[icell]->getPosX() + 0.5*_size_cell;
-	real_t avgQ = zone->getDOF()[0][icell];
-	real_t del_m = projectionTo(1, zone, icell, coord_x_right) - avgQ;
+	real_t avgQ = cell.avgQ;
+	real_t del_m = cell.slope;
 
 	// Compute MLP function
 	if (del_m > epsilon)
 	{
-		limit_ftn_right = limit_PI(std::max(zone->getDOF()[0][icell], zone->getDOF()[0][icell + 1]) - avgQ, del_m);
-		limit_ftn_left = limit_PI(std::min(zone->getDOF()[0][icell - 1], zone->getDOF()[0][icell]) - avgQ, -del_m);
+		limit_ftn_right = limit_PI(limiter, cell.maxRightAvgQ - avgQ, del_m, cell.size_cell);
+		limit_ftn_left = limit_PI(limiter, cell.minLeftAvgQ - avgQ, -del_m, cell.size_cell);
 	}
 	else if (del_m < -epsilon)
 	{
-		limit_ftn_right = limit_PI(std::min(zone->getDOF()[0][icell], zone->getDOF()[0][icell + 1]) - avgQ, del_m);
-		limit_ftn_left = limit_PI(std::max(zone->getDOF()[0][icell - 1], zone->getDOF()[0][icell]) - avgQ, -del_m);
+		limit_ftn_right = limit_PI(limiter, cell.minRightAvgQ - avgQ, del_m, cell.size_cell);
+		limit_ftn_left = limit_PI(limiter, cell.maxLeftAvgQ - avgQ, -del_m, cell.size_cell);
 	}
 	else return 1.0;
 
 	return std::min(limit_ftn_right, limit_ftn_left);
 }
 
-real_t Limiter::limit_PI(real_t del_p, real_t del_m) const
+real_t Limiter::limit_PI(const Type& limiter, real_t del_p, real_t del_m, real_t size_cell)
 {
-	if (_limiter == "MLP-u1") return std::min(1.0, del_p / del_m);
-	if (_limiter == "MLP-u2") return MLP_u2(del_p, del_m);
+	if (limiter == "MLP-u1") return std::min(1.0, del_p / del_m);
+	if (limiter == "MLP-u2") return MLP_u2(del_p, del_m, size_cell);
 	ERROR("cannot find limiter");
 	return 0;
 }
 
-real_t Limiter::MLP_u2(real_t del_p, real_t del_m) const
+real_t Limiter::MLP_u2(real_t del_p, real_t del_m, real_t size_cell)
 {
-	real_t ep = pow(CONST_K*_size_cell, 1.5);
+	real_t ep = pow(CONST_K*size_cell, 1.5);
 	real_t num = (pow(del_p, 2.0) + pow(ep, 2.0))*del_m + 2.0*pow(del_m, 2.0)*del_p;
 	real_t den = del_m*(pow(del_p, 2.0) + 2.0*pow(del_m, 2.0) + del_m*del_p + pow(ep, 2.0));
 
 	return num / den;
-}
-
-real_t Limiter::projectionTo(int_t degree, std::shared_ptr<Zone> zone, int_t icell, real_t coord_x) const
-{
-	// Temporary object
-	std::shared_ptr<Zone> temp_zone = std::make_shared<Zone>(*zone);
-	std::vector<std::vector<real_t> > temp_DOF = zone->getDOF();
-	std::vector<real_t> zero_DOF(_num_cell, 0.0);
-	
-	// Projection to n degree
-	for (int_t idegree = _polyOrder; idegree > degree; --idegree)
-	{
-		temp_DOF[idegree] = zero_DOF;
-	}
-
-	temp_zone->setDOF(temp_DOF);
-
-	return temp_zone->getPolySolution(icell, coord_x);
 }
\ No newline at end of file
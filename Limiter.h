@@ -4,6 +4,22 @@
 
 #define CONST_K 1
 
+// Face traces and averages around one cell, all the hMLP markers and the MLP limiter read
+struct LimiterStencil
+{
+	real_t avgQ; /// average of cell
+	real_t leftQ; /// solution at left face
+	real_t rightQ; /// solution at right face
+	real_t slope; /// P1 projection at right face minus average
+	real_t prevQ; /// left neighbor at left face
+	real_t nextQ; /// right neighbor at right face
+	real_t maxLeftAvgQ; /// maximum average of cells of left face
+	real_t minLeftAvgQ;
+	real_t maxRightAvgQ; /// maximum average of cells of right face
+	real_t minRightAvgQ;
+	real_t size_cell;
+};
+
 class Limiter
 {
 public:
@@ -18,36 +34,67 @@ public:
 	// calculate local projection limiter / p.m. Zone(object)
 	void hMLP_Limiter(std::shared_ptr<Zone>);
 
+	// calculate local projection limiter of cell range, other cells are left as they are
+	// The range is screened once, later steps mark troubled cells and their neighbors only / p.m. Zone(object), begin cell, end cell(exclusive)
+	void hMLP_Limiter(std::shared_ptr<Zone>, int_t, int_t);
+
+	// Order of every cell from projected degree of last limiting, raised to full order without jumps on faces / p.m. Zone(object, adaptive order)
+	void adaptDegree(std::shared_ptr<Zone>);
+
+	// Face traces of cell range and its neighbors, read by the markers and MLP limiter until DOF change / p.m. Zone(object), begin cell, end cell(exclusive)
+	void computeTrace(std::shared_ptr<Zone>, int_t, int_t);
+
+	// Troubled cell of full-degree solution or jump on its faces for grid adaptation, nearly constant stencils are smooth
+	// Face traces of the cell and its neighbors are computed before / p.m. Zone(object), cell number
+	bool isTroubled(std::shared_ptr<Zone>, int_t) const;
+
+	// Decisions of one stencil, shared by the single-case and ensemble limiters
+	// Troubled-cell marker / p.m. stencil, current degree / r.t. false : troubled
+	static bool troubleCellMarker(const LimiterStencil&, int_t);
+
+	// Compute MLP limiter / p.m. limiter type, stencil
+	static real_t MLP_limit_ftn(const Type&, const LimiterStencil&);
+
 protected:
 	// Variables
 	Type _limiter;
 	int_t _polyOrder;
 	int_t _num_cell;
-	real_t _size_cell;
+	// Work storage reused every call
+	std::vector<int_t> _projectDegree;
+	std::vector<int_t> _marker; /// int_t, cells are marked concurrently
+	std::vector<int_t> _candidate; /// cells to mark at current step, ascending
+	std::vector<int_t> _troubled; /// troubled cells of current step, ascending
+	// Face trace cache, face i is left of cell i
+	std::vector<real_t> _faceLeft; /// mode times its coefficient at left face
+	std::vector<real_t> _faceRight; /// mode times its coefficient at right face
+	std::vector<real_t> _leftQ; /// solution at left face of cell
+	std::vector<real_t> _rightQ; /// solution at right face of cell
+	std::vector<real_t> _slope; /// P1 projection at right face minus average
+	std::vector<real_t> _maxAvgQ; /// maximum average of cells of face
+	std::vector<real_t> _minAvgQ; /// minimum average of cells of face
 
 protected:
 	// Functions
-	// Projection n degree DOF to n-1 degree / p.m. Zone(object), current degree, troubled-cell marker
-	void troubleCellProject(std::shared_ptr<Zone>, std::vector<int_t>&, const std::vector<bool>&);
+	// Projection n degree DOF to n-1 degree in place / p.m. Zone(object), current degree, troubled cells
+	void troubleCellProject(std::shared_ptr<Zone>, std::vector<int_t>&, const std::vector<int_t>&);
 
-	// Troubled-cell marker / p.m. Zone(object), current degree, cell number
-	bool troubleCellMarker(std::shared_ptr<Zone>, int_t, int_t) const;
+	// Face traces of one cell / p.m. DOF, cell number
+	void traceCell(const DOFArray&, int_t);
 
-	// MLP-based troubled-cell marker(Augmented MLP condition) / p.m. Zone(object), cell number
-	bool augmentMLPmarker(std::shared_ptr<Zone>, int_t) const;
+	// Stencil of a cell from the face trace cache / p.m. Zone(object), cell number
+	LimiterStencil stencil(std::shared_ptr<Zone>, int_t) const;
 
-	// hierarchical troubled-cell marker(Smooth extrema detector) / p.m. Zone(object), cell number
-	bool extremaDetector(std::shared_ptr<Zone>, int_t) const;
+	// MLP-based troubled-cell marker(Augmented MLP condition) / p.m. stencil
+	static bool augmentMLPmarker(const LimiterStencil&);
 
-	// Compute MLP limiter / p.m. Zone(object), cell number
-	real_t MLP_limit_ftn(std::shared_ptr<Zone>, int_t) const;
+	// hierarchical troubled-cell marker(Smooth extrema detector) / p.m. stencil
+	static bool extremaDetector(const LimiterStencil&);
 
-	// Compute limiting PI / p.m. vertex difference, linear reconstruction
-	real_t limit_PI(real_t, real_t) const;
+	// Compute limiting PI / p.m. limiter type, vertex difference, linear reconstruction, cell size
+	static real_t limit_PI(const Type&, real_t, real_t, real_t);
 
-	// Compute MLP-u2(or MLP-Venkatakrishnan) limiter / p.m. vertex difference, linear reconstruction
-	real_t MLP_u2(real_t, real_t) const;
+	// Compute MLP-u2(or MLP-Venkatakrishnan) limiter / p.m. vertex difference, linear reconstruction, cell size
+	static real_t MLP_u2(real_t, real_t, real_t);
 
-	// Compute projection / p.m. degree of projected P, Zone to project, cell number, x coordinate
-	real_t projectionTo(int_t, std::shared_ptr<Zone>, int_t, real_t) const;
 };
\ No newline at end of file
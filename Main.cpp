@@ -5,31 +5,182 @@
 #include "InitialCondition.h"
 #include "TimeIntegEuler.h"
 #include "TimeIntegRK.h"
+#include "TimeIntegLTS.h"
 #include "Post.h"
 #include "Boundary.h"
 #include "OrderTest.h"
+#include "SIMDKernel.h"
+#include "ThreadPool.h"
+#include "Decomposition.h"
+#include "Ensemble.h"
+#include "ConvergenceTest.h"
+#include "Snapshot.h"
+#include "AsyncWriter.h"
+#include "Checkpoint.h"
+#include "Timer.h"
+#include "Adaptation.h"
 
 // Modified 2017-05-16
 // by Juhyeon Kim
 // Caution : polynomial order starts from 0
 
-int main()
+// Ensemble mode : march cases of file in batches of SIMD lanes and write errors of every case
+void runEnsemble(std::shared_ptr<Reader> reader, std::shared_ptr<Grid> grid)
 {
+	if (Decomposition::getSize() > 1) ERROR("ensemble runs on a single rank");
+	if (reader->getTimeInteg() != "RK3") ERROR("ensemble supports RK3 only");
+	if (reader->getBasis() != "modal") ERROR("ensemble supports modal basis only");
+
+	std::vector<EnsembleCase> cases = Ensemble::readCases(reader->getEnsembleFile());
+	std::shared_ptr<Ensemble> ensemble = Ensemble::create(reader->getEnsembleWidth(), reader->getPDE(), reader->getLimiter(), reader->getBoundary(), reader->getInitial(), reader->getTargetT(), grid, reader->getPolyOrder());
+	std::shared_ptr<Zone> zone = std::make_shared<Zone>(grid, reader->getPolyOrder());
+	std::vector<std::shared_ptr<OrderTest> > orderTest(ensemble->getWidth());
+	MESSAGE("Ensemble of " + std::to_string(cases.size()) + " cases");
+
+	// Error table
+	std::string fileName = "./output/test/RKDG_1D_P" + std::to_string(reader->getPolyOrder()) + "_ensemble_" + reader->getPDE() + "_" + reader->getInitial() + ".dat";
+	std::ofstream file;
+	file.open(fileName, std::ios::trunc);
+	if (!file.is_open()) ERROR("cannot open output file");
+	file << "case\tspeed\tamplitude\tCFL\tsteps\ttime\tL1\tL2\tLinf\n";
+	file.precision(16);
+
+	for (size_t first = 0; first < cases.size(); first += ensemble->getWidth())
+	{
+		std::vector<EnsembleCase> batch(cases.begin() + first, cases.begin() + std::min(first + ensemble->getWidth(), cases.size()));
+		ensemble->initialize(batch);
+
+		// Save exact solution of every lane
+		for (size_t lane = 0; lane < batch.size(); ++lane)
+		{
+			ensemble->extract(lane, zone);
+			orderTest[lane] = std::make_shared<OrderTest>();
+			orderTest[lane]->setExact(orderTest[lane]->ZoneToPoly(zone));
+		}
+
+		// Time marching of all lanes
+		int_t iter = 0;
+		while (ensemble->march())
+		{
+			iter++;
+			if (iter % 100 == 0) MESSAGE("Iteration = " + std::to_string(iter));
+		}
+
+		// Compute L errors of every lane
+		for (size_t lane = 0; lane < batch.size(); ++lane)
+		{
+			ensemble->extract(lane, zone);
+			std::vector<real_t> computed = orderTest[lane]->ZoneToPoly(zone);
+			file << first + lane << "\t" << batch[lane].speed << "\t" << batch[lane].amplitude << "\t" << batch[lane].CFL << "\t"
+				<< ensemble->getNumStep(lane) << "\t" << ensemble->getTime(lane) << "\t"
+				<< orderTest[lane]->L1error(computed) << "\t" << orderTest[lane]->L2error(computed) << "\t" << orderTest[lane]->Linf_error(computed) << "\n";
+		}
+	}
+
+	file.close();
+	MESSAGE("Ensemble errors : " + fileName);
+}
+
+// Converter mode : Tecplot file next to every binary snapshot
+int convertSnapshot(int argc, char* argv[])
+{
+	for (int ifile = 2; ifile < argc; ++ifile)
+	{
+		std::string name = argv[ifile];
+		std::string plt = name.substr(0, name.rfind(".rkb")) + ".plt";
+		SnapshotReader(name).toTecplot(plt);
+		MESSAGE("Converted : " + plt);
+	}
+	return 0;
+}
+
+int main(int argc, char* argv[])
+{
+	// rkdg --convert <snapshot files>
+	if ((argc > 1) && (std::string(argv[1]) == "--convert")) return convertSnapshot(argc, argv);
+
+	// Start MPI ranks, messages from root rank only
+	Decomposition::initialize(&argc, &argv);
+	Alert::setSilent(!Decomposition::isRoot());
+
+	// rkdg --restart <checkpoint file> : input of checkpoint instead of input file
+	std::string restartFile;
+	if ((argc > 2) && (std::string(argv[1]) == "--restart")) restartFile = Checkpoint::rankFile(argv[2]);
+
 	// Read input file
 	std::shared_ptr<Reader> reader = std::make_shared<Reader>();
-	if (!reader->readFile("./input.inp")) return 0;
+	if (restartFile != "") reader->readText(Checkpoint::readInput(restartFile));
+	else if (!reader->readFile("./input.inp"))
+	{
+		Decomposition::finalize();
+		return 0;
+	}
 
 	// Set advection speed
 	if (reader->getPDE() == "advection") SET_SPEED(reader->getAdvSpeed());
 
+	// Select instruction set of RHS kernels
+	SIMDKernel::setLevel(SIMDKernel::select(reader->getSIMD()));
+
+	// Start threads
+	ThreadPool::setNumThread(ThreadPool::select(reader->getNumThread()));
+	MESSAGE("Number of threads = " + std::to_string(ThreadPool::getNumThread()));
+	if (Decomposition::getSize() > 1) MESSAGE("Number of ranks = " + std::to_string(Decomposition::getSize()));
+
 	// Initializing objects
 	std::shared_ptr<Post> post = std::make_shared<Post>(reader);
-	std::shared_ptr<Grid> grid = std::make_shared<Grid>(reader->getArea(), reader->getSizeX());
-	std::shared_ptr<Zone> zone = std::make_shared<Zone>(grid, reader->getPolyOrder());
+	std::shared_ptr<Grid> grid;
+	if (reader->getGridType() == "uniform")
+		grid = std::make_shared<Grid>(reader->getArea(), reader->getSizeX(), Decomposition::getRank(), Decomposition::getSize());
+	else
+	{
+		const std::vector<real_t> parameter = (reader->getGridType() == "stretched") ? std::vector<real_t>(1, reader->getGridStretch()) : reader->getGridCluster();
+		grid = std::make_shared<Grid>(Grid::makeNode(reader->getGridType(), reader->getArea(), reader->getSizeX(), parameter, reader->getGridFile()), Decomposition::getRank(), Decomposition::getSize());
+	}
+
+	// Grid-refinement study instead of single run
+	if (!reader->getConvSizeX().empty())
+	{
+		std::make_shared<ConvergenceTest>(reader)->run();
+		Decomposition::finalize();
+		return 0;
+	}
+
+	// Ensemble of cases instead of single run
+	if (reader->getEnsembleFile() != "")
+	{
+		runEnsemble(reader, grid);
+		Decomposition::finalize();
+		return 0;
+	}
+
+	std::shared_ptr<Zone> zone = std::make_shared<Zone>(grid, reader->getPolyOrder(), reader->getDOFLayout());
 	std::shared_ptr<OrderTest> orderTest = std::make_shared<OrderTest>();
 
+	// DOF representation, nodal DOF are values at Gauss-Lobatto nodes
+	if (reader->getBasis() == "nodal") zone->setNodal(true);
+	else if (reader->getBasis() != "modal") ERROR("cannot find basis");
+
 	// Initializing solution domain
-	zone->initialize(std::make_shared<InitialCondition>(reader->getInitial()));
+	std::shared_ptr<InitialCondition> initialCondition = std::make_shared<InitialCondition>(reader->getInitial());
+	zone->initialize(initialCondition);
+
+	// Adaptive grid refined on initial condition
+	std::shared_ptr<Adaptation> adaptation;
+	if (reader->getAMRLevel() > 0)
+	{
+		if ((restartFile != "") || (reader->getCheckpointStep() > 0) || (reader->getCheckpointWallTime() > 0.0))
+			ERROR("checkpoint of adaptive grid is not supported");
+		if (zone->isNodal()) ERROR("adaptive grid supports modal basis only");
+		adaptation = std::make_shared<Adaptation>(reader->getAMRLevel(), reader->getAMRInterval(), reader->getCFL(), reader->getBoundary(), zone);
+		adaptation->initialize(zone, initialCondition);
+		MESSAGE("Initial adaptive grid cells = " + std::to_string(zone->getGrid()->getNumGlobalCell()));
+	}
+
+	// Order of cells follows the limiter
+	if ((reader->getAdaptiveOrder() == "on") && zone->isNodal()) ERROR("adaptive order supports modal basis only");
+	if (reader->getAdaptiveOrder() == "on") zone->setAdaptiveOrder(true);
+	else if (reader->getAdaptiveOrder() != "off") ERROR("cannot find adaptive order option");
 
 	// initializing boundary condition
 	std::shared_ptr<Boundary> bdry = std::make_shared<Boundary>(reader->getBoundary(), zone);
@@ -38,31 +189,84 @@ int main()
 	std::vector<real_t> exact = orderTest->ZoneToPoly(zone);
 	orderTest->setExact(exact);
 
-	// Post initial condition
-	post->solution("initial", zone);
-	if (reader->getPolyOrder() > 0) post->DGsolution("initial", zone);
-
-	// Initialzing time integrator
-	std::shared_ptr<TimeInteg> timeInteg;
+	// Post initial condition, DG solutions by background writer
+	std::shared_ptr<AsyncWriter> writer = std::make_shared<AsyncWriter>(post, zone, reader->getNumOutputBuffer());
+	if (restartFile == "")
+	{
+		post->solution("initial", zone);
+		if (reader->getPolyOrder() > 0) writer->DGsolution("initial", zone, 0.0);
+	}
 
-	if (reader->getTimeInteg() == "Euler")
-		timeInteg = std::make_shared<TimeIntegEuler>
-		(reader->getPDE(), reader->getFluxScheme(), reader->getLimiter(), reader->getCFL(), reader->getTargetT(), zone, bdry);
-	else if (reader->getTimeInteg() == "RK3")
-		timeInteg = std::make_shared<TimeIntegRK>
-		(reader->getPDE(), reader->getFluxScheme(), reader->getLimiter(), reader->getCFL(), reader->getTargetT(), zone, bdry, 3);
-	else ERROR("cannot find time integrator");
+	// Initialzing time integrator, again for every adapted grid
+	auto makeTimeInteg = [&]()
+	{
+		std::shared_ptr<TimeInteg> timeInteg;
+		if (reader->getTimeInteg() == "Euler")
+			timeInteg = std::make_shared<TimeIntegEuler>
+			(reader->getPDE(), reader->getFluxScheme(), reader->getLimiter(), reader->getCFL(), reader->getTargetT(), zone, bdry);
+		else if (reader->getTimeInteg() == "RK3")
+			timeInteg = std::make_shared<TimeIntegRK>
+			(reader->getPDE(), reader->getFluxScheme(), reader->getLimiter(), reader->getCFL(), reader->getTargetT(), zone, bdry, 3);
+		else if (reader->getTimeInteg() == "LTS-RK3")
+			timeInteg = std::make_shared<TimeIntegLTS>
+			(reader->getPDE(), reader->getFluxScheme(), reader->getLimiter(), reader->getCFL(), reader->getTargetT(), zone, bdry, reader->getLTSLevel());
+		else ERROR("cannot find time integrator");
+		return timeInteg;
+	};
+	std::shared_ptr<TimeInteg> timeInteg = makeTimeInteg();
 
 	// Print initialized solution
 	// zone->print();
 
+	// Resume integrator state of checkpoint
+	std::shared_ptr<Checkpoint> checkpoint = std::make_shared<Checkpoint>(reader);
 	int_t iter = 0;
+	if (restartFile != "") iter = Checkpoint::restore(restartFile, zone, timeInteg, bdry);
+	const int_t first_iter = iter;
+	Timer::start();
+
 	// Time marching
 	while (timeInteg->march(zone))
 	{
 		iter++;
 		if (iter % 100 == 0) MESSAGE("Iteration = " + std::to_string(iter));
-		if (reader->getPolyOrder() > 0) post->DGsolution("result" + std::to_string(iter), zone);
+
+		// Objects of the adapted grid continue the run
+		if (adaptation && adaptation->update(iter, zone, bdry))
+		{
+			std::vector<real_t> state;
+			bdry->save(state);
+			bdry = std::make_shared<Boundary>(reader->getBoundary(), zone);
+			bdry->load(state);
+			const real_t time = timeInteg->getTime();
+			const real_t timeStep = timeInteg->getTimeStep();
+			timeInteg = makeTimeInteg();
+			timeInteg->restart(time, timeStep);
+			writer->reshape(zone);
+		}
+
+		if (reader->getPolyOrder() > 0) writer->DGsolution("result" + std::to_string(iter), zone, timeInteg->getTime());
+		checkpoint->update(iter, zone, timeInteg, bdry);
+	}
+
+	// Exact solution on the adapted grid
+	if (adaptation)
+	{
+		std::shared_ptr<Zone> exactZone = std::make_shared<Zone>(zone->getGrid(), reader->getPolyOrder(), reader->getDOFLayout());
+		exactZone->initialize(initialCondition);
+		orderTest->setExact(orderTest->ZoneToPoly(exactZone));
+		MESSAGE("Adaptive grid : " + std::to_string(adaptation->getNumRemesh()) + " remeshes, cells average " + std::to_string(adaptation->getAverageCell())
+			+ ", maximum " + std::to_string(adaptation->getMaxCell()) + ", final " + std::to_string(zone->getGrid()->getNumGlobalCell()));
+	}
+
+	if (zone->isAdaptiveOrder())
+	{
+		const std::vector<int_t>& degree = zone->getDegree();
+		int_t num_reduced = 0;
+		for (int_t icell = GHOST; icell < zone->getGrid()->getNumCell() - GHOST; ++icell)
+			if (degree[icell] < reader->getPolyOrder()) num_reduced++;
+		num_reduced = Decomposition::sumAll(real_t(num_reduced));
+		MESSAGE("Cells below polynomial order at end = " + std::to_string(num_reduced));
 	}
 
 	// Computed solution array
@@ -74,13 +278,20 @@ int main()
 	real_t Linf = orderTest->Linf_error(computed);
 
 	// Print L errors
-	std::cout << "L1 error    = " << L1 << "\n";
-	std::cout << "L2 error    = " << L2 << "\n";
-	std::cout << "L inf error = " << Linf << "\n";
+	if (Decomposition::isRoot())
+	{
+		std::cout << "L1 error    = " << L1 << "\n";
+		std::cout << "L2 error    = " << L2 << "\n";
+		std::cout << "L inf error = " << Linf << "\n";
+	}
 
 	// Post solution
 	post->solution("result", zone);
-	if(reader->getPolyOrder() > 0) post->DGsolution("result", zone);
+	if(reader->getPolyOrder() > 0) writer->DGsolution("result", zone, timeInteg->getTime());
+	writer->flush();
+	if (writer->getNumWait() > 0) MESSAGE("Output waited for free buffer " + std::to_string(writer->getNumWait()) + " times");
+	Timer::summary(iter - first_iter, adaptation ? adaptation->getAverageCell() : grid->getNumGlobalCell());
 
+	Decomposition::finalize();
 	return 0;
 }
\ No newline at end of file
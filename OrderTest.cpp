@@ -1,4 +1,5 @@
 #include "OrderTest.h"
+#include "Decomposition.h"
 
 OrderTest::OrderTest()
 {
@@ -27,16 +28,18 @@ std::vector<real_t> OrderTest::ZoneToPoly(std::shared_ptr<Zone> zone)
 {
 	std::vector<real_t> solution;
 	std::vector<std::shared_ptr<Cell> > cell = zone->getGrid()->getCell();
-	real_t sizeX = zone->getGrid()->getSizeX();
+	_weight.clear();
 
 	for (int_t icell = 0; icell < zone->getGrid()->getNumCell(); ++icell)
 	{
 		if (cell[icell]->getType() == true)
 		{
 			real_t posX = cell[icell]->getPosX();
+			real_t sizeX = cell[icell]->getSizeX();
 			for (int_t idegree = 0; idegree < QuadDegree; ++idegree)
 			{
 				solution.push_back(zone->getPolySolution(icell, posX + 0.5*sizeX*Gauss3_X(idegree)));
+				_weight.push_back(sizeX / zone->getGrid()->getMinSizeX());
 			}
 		}
 	}
@@ -46,16 +49,18 @@ std::vector<real_t> OrderTest::ZoneToPoly(std::shared_ptr<Zone> zone)
 
 real_t OrderTest::L1error(std::vector<real_t> computed)
 {
-	int_t num = _exact.size();
-	if (num != computed.size()) ERROR("different number of solutions");
+	if (_num != computed.size()) ERROR("different number of solutions");
 
 	real_t L1 = 0;
-	for (int_t icell = 0; icell < num; ++icell)
+	real_t weight = 0;
+	for (int_t icell = 0; icell < _num; ++icell)
 	{
-		L1 += abs(computed[icell] - _exact[icell]);
+		L1 += _weight[icell] * std::abs(computed[icell] - _exact[icell]);
+		weight += _weight[icell];
 	}
 
-	L1 /= double(num);
+	// Sum over every rank
+	L1 = Decomposition::sumAll(L1) / Decomposition::sumAll(weight);
 
 	return L1;
 }
@@ -65,11 +70,14 @@ real_t OrderTest::L2error(std::vector<real_t> computed)
 	if (_num != computed.size()) ERROR("different number of solutions");
 
 	real_t L2 = 0;
+	real_t weight = 0;
 	for (int_t icell = 0; icell < _num; ++icell)
 	{
-		L2 += pow(computed[icell] - _exact[icell], 2.0);
+		L2 += _weight[icell] * pow(computed[icell] - _exact[icell], 2.0);
+		weight += _weight[icell];
 	}
-	L2 /= double(_num);
+	// Sum over every rank
+	L2 = Decomposition::sumAll(L2) / Decomposition::sumAll(weight);
 	L2 = sqrt(L2);
 
 	return L2;
@@ -83,8 +91,9 @@ real_t OrderTest::Linf_error(std::vector<real_t> computed)
 	real_t diff = 0;
 	for (int_t icell = 0; icell < _num; ++icell)
 	{
-		Linf =std::max(Linf, abs(computed[icell] - _exact[icell]));
+		Linf =std::max(Linf, std::abs(computed[icell] - _exact[icell]));
 	}
+	Linf = Decomposition::maxAll(Linf);
 
 	return Linf;
 }
\ No newline at end of file
@@ -20,10 +20,10 @@ public:
 	// Convert Zone to solution array / p.m. Zone
 	std::vector<real_t> ZoneToArray(std::shared_ptr<Zone>);
 
-	// Convert Zone to polynomical solution array / p.m. Zone
+	// Convert Zone to polynomical solution array, sets weights of points / p.m. Zone
 	std::vector<real_t> ZoneToPoly(std::shared_ptr<Zone>);
 
-	// Calculate error / p.m. computed solution
+	// Calculate error, points weighted by cell size / p.m. computed solution
 	real_t L1error(std::vector<real_t>);
 
 	real_t L2error(std::vector<real_t>);
@@ -33,5 +33,6 @@ public:
 protected:
 	// Variables
 	std::vector<real_t> _exact;
+	std::vector<real_t> _weight; /// cell size of point relative to smallest cell
 	int_t _num;
 };
\ No newline at end of file
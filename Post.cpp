@@ -1,4 +1,7 @@
 #include "Post.h"
+#include "Decomposition.h"
+#include "Snapshot.h"
+#include "Timer.h"
 
 Post::Post(std::shared_ptr<Reader> reader)
 {
@@ -12,6 +15,8 @@ Post::~Post()
 
 void Post::solution(std::shared_ptr<Zone> zone) const
 {
+	TIMER_SCOPE(Phase::Output);
+
 	// Determine file name
 	std::string fileName = "./output/test/";
 	fileName += "RKDG_1D_P";
@@ -24,12 +29,9 @@ void Post::solution(std::shared_ptr<Zone> zone) const
 	fileName += std::to_string(_reader->getCFL());
 	fileName += ".plt";
 
-	// Cell size
-	real_t dx = zone->getGrid()->getSizeX();
-
 	// Build solution arrays to post
 	std::vector<std::shared_ptr<Cell> > cell = zone->getGrid()->getCell();
-	std::vector<real_t> solution = zone->getDescSolution();
+	const std::vector<real_t>& solution = zone->getDescSolution();
 	std::vector<real_t> X;
 	std::vector<real_t> U;
 	for (int_t icell = 0; icell < zone->getGrid()->getNumCell(); ++icell)
@@ -47,6 +49,8 @@ void Post::solution(std::shared_ptr<Zone> zone) const
 
 void Post::solution(const std::string& name, std::shared_ptr<Zone> zone) const
 {
+	TIMER_SCOPE(Phase::Output);
+
 	// Determine file name
 	std::string fileName = "./output/test/";
 	fileName += "RKDG_1D_P";
@@ -63,7 +67,7 @@ void Post::solution(const std::string& name, std::shared_ptr<Zone> zone) const
 
 	// Build solution arrays to post
 	std::vector<std::shared_ptr<Cell> > cell = zone->getGrid()->getCell();
-	std::vector<real_t> solution = zone->getDescSolution();
+	const std::vector<real_t>& solution = zone->getDescSolution();
 	std::vector<real_t> X;
 	std::vector<real_t> U;
 	for (int_t icell = 0; icell < zone->getGrid()->getNumCell(); ++icell)
@@ -99,13 +103,12 @@ void Post::DGsolution(const std::string& name, std::shared_ptr<Zone> zone) const
 	std::vector<std::shared_ptr<Cell> > cell = zone->getGrid()->getCell();
 	std::vector<real_t> X;
 	std::vector<real_t> U;
-	real_t sizeX = zone->getGrid()->getSizeX();
-	real_t dx = zone->getGrid()->getSizeX() / double(POST_GRID_NUM);
 	for (int_t icell = 0; icell < zone->getGrid()->getNumCell(); ++icell)
 	{
 		if (cell[icell]->getType() == true)
 		{
 			real_t posX = cell[icell]->getPosX();
+			real_t sizeX = cell[icell]->getSizeX();
 			for (int_t idegree = 0; idegree < QuadDegree; ++idegree)
 			{
 				X.push_back(posX + 0.5*sizeX*Gauss3_X(idegree));
@@ -118,13 +121,46 @@ void Post::DGsolution(const std::string& name, std::shared_ptr<Zone> zone) const
 	write(fileName, "X", "Velocity", X, U);
 }
 
+void Post::DGsolution(const std::string& name, std::shared_ptr<Zone> zone, real_t time) const
+{
+	if (_reader->getOutputFormat() == "plt")
+	{
+		DGsolution(name, zone);
+		return;
+	}
+	if (_reader->getOutputFormat() != "binary") ERROR("cannot find output format");
+
+	// Determine file name
+	std::string fileName = "./output/test/";
+	fileName += "RKDG_1D_P";
+	fileName += std::to_string(zone->getPolyOrder());
+	fileName += "_DGsolution_";
+	fileName += _reader->getPDE();
+	fileName += "_";
+	fileName += _reader->getInitial();
+	fileName += "_CFL=";
+	fileName += std::to_string(_reader->getCFL());
+	fileName += "_";
+	fileName += name;
+	if (Decomposition::getSize() > 1) fileName += "_rank" + std::to_string(Decomposition::getRank());
+	fileName += ".rkb";
+
+	// Raw DOF and quadrature-point solution, Tecplot file by converter
+	Snapshot::write(fileName, zone, time);
+}
+
 void Post::error(std::shared_ptr<Zone> zone) const
 {
 
 }
 
-void Post::write(const std::string& fileName, const std::string& VN1, const std::string& VN2, std::vector<real_t> V1, std::vector<real_t> V2) const
+void Post::write(const std::string& name, const std::string& VN1, const std::string& VN2, std::vector<real_t> V1, std::vector<real_t> V2) const
 {
+	// One file per rank for decomposed domain
+	std::string fileName = name;
+	if (Decomposition::getSize() > 1)
+		fileName.insert(fileName.rfind(".plt"), "_rank" + std::to_string(Decomposition::getRank()));
+
 	std::ofstream file;
 	file.open(fileName, std::ios::trunc);
 	int_t _num_element = V1.size();
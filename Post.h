@@ -22,6 +22,9 @@ public:
 
 	// Export DG solution file / p.m. file name, Zone(object)
 	void DGsolution(const std::string&, std::shared_ptr<Zone>) const;
+
+	// Export DG solution in output format of input file, binary snapshot(.rkb) or Tecplot / p.m. file name, Zone(object), time
+	void DGsolution(const std::string&, std::shared_ptr<Zone>, real_t) const;
 	
 	// Export error log / p.m. Zone(object)
 	void error(std::shared_ptr<Zone>) const;
@@ -2,7 +2,71 @@
 
 Quadrature::Quadrature()
 {
+	// Roots of Legendre polynomial by Newton iteration from Chebyshev guess, closed forms for 2 and 3 points
+	_X.resize(MAX_QUAD + 1);
+	_W.resize(MAX_QUAD + 1);
+	for (int_t num = 1; num <= MAX_QUAD; ++num)
+	{
+		_X[num].resize(num);
+		_W[num].resize(num);
+		for (int_t index = 0; index < num; ++index)
+		{
+			real_t x = -cos(M_PI*(index + 0.75) / (num + 0.5));
+			real_t dP = 1.0;
+			for (int_t iter = 0; iter < 100; ++iter)
+			{
+				// P(num) and its derivative by recursion
+				real_t P0 = 1.0;
+				real_t P1 = x;
+				for (int_t n = 1; n < num; ++n)
+				{
+					real_t P2 = ((2 * n + 1)*x*P1 - n*P0) / double(n + 1);
+					P0 = P1;
+					P1 = P2;
+				}
+				dP = num*(x*P1 - P0) / (x*x - 1.0);
+				real_t dx = P1 / dP;
+				x -= dx;
+				if (std::abs(dx) < 1.0e-15) break;
+			}
+			_X[num][index] = x;
+			_W[num][index] = 2.0 / ((1.0 - x*x)*dP*dP);
+		}
+	}
+	for (int_t index = 0; index < 2; ++index) { _X[2][index] = gauss2X(index); _W[2][index] = gauss2W(index); }
+	for (int_t index = 0; index < 3; ++index) { _X[3][index] = gauss3X(index); _W[3][index] = gauss3W(index); }
 
+	// End points and roots of derivative of Legendre polynomial P(num-1), Newton iteration from Chebyshev-Lobatto guess
+	_lobattoX.resize(MAX_QUAD + 1);
+	_lobattoW.resize(MAX_QUAD + 1);
+	for (int_t num = 2; num <= MAX_QUAD; ++num)
+	{
+		const int_t N = num - 1;
+		_lobattoX[num].resize(num);
+		_lobattoW[num].resize(num);
+		for (int_t index = 0; index < num; ++index)
+		{
+			real_t x = -cos(M_PI*index / N);
+			real_t P1 = 1.0;
+			for (int_t iter = 0; iter < 100; ++iter)
+			{
+				// P(N) and P(N-1) by recursion
+				real_t P0 = 1.0;
+				P1 = x;
+				for (int_t n = 1; n < N; ++n)
+				{
+					real_t P2 = ((2 * n + 1)*x*P1 - n*P0) / double(n + 1);
+					P0 = P1;
+					P1 = P2;
+				}
+				real_t dx = (x*P1 - P0) / (num*P1);
+				x -= dx;
+				if (std::abs(dx) < 1.0e-15) break;
+			}
+			_lobattoX[num][index] = x;
+			_lobattoW[num][index] = 2.0 / (N*num*P1*P1);
+		}
+	}
 }
 
 Quadrature::~Quadrature()
@@ -47,4 +111,28 @@ real_t Quadrature::gauss3W(int_t index)
 	}
 }
 
+real_t Quadrature::gaussX(int_t num, int_t index)
+{
+	if ((num < 1) || (num > MAX_QUAD)) ERROR("Exceed maximum number of quadrature points");
+	return _quad._X[num][index];
+}
+
+real_t Quadrature::gaussW(int_t num, int_t index)
+{
+	if ((num < 1) || (num > MAX_QUAD)) ERROR("Exceed maximum number of quadrature points");
+	return _quad._W[num][index];
+}
+
+real_t Quadrature::gaussLobattoX(int_t num, int_t index)
+{
+	if ((num < 2) || (num > MAX_QUAD)) ERROR("Exceed maximum number of quadrature points");
+	return _quad._lobattoX[num][index];
+}
+
+real_t Quadrature::gaussLobattoW(int_t num, int_t index)
+{
+	if ((num < 2) || (num > MAX_QUAD)) ERROR("Exceed maximum number of quadrature points");
+	return _quad._lobattoW[num][index];
+}
+
 Quadrature Quadrature::_quad;
\ No newline at end of file
@@ -1,6 +1,9 @@
 #pragma once
 #include "DataType.h"
 
+// Gauss-Legendre points are tabulated up to MAX_QUAD points
+#define MAX_QUAD 32
+
 class Quadrature
 {
 protected:
@@ -15,9 +18,25 @@ public:
 	static real_t gauss2W(int_t);
 	static real_t gauss3W(int_t);
 
+	// Gauss-Legendre quadrature of any number of points / p.m. number of points, index
+	static real_t gaussX(int_t, int_t);
+	static real_t gaussW(int_t, int_t);
+
+	// Gauss-Lobatto quadrature including end points, exact up to 2*num-3 degree / p.m. number of points(2~), index
+	static real_t gaussLobattoX(int_t, int_t);
+	static real_t gaussLobattoW(int_t, int_t);
+
+	// Points integrating the volume term of polynomial order exactly, max(3, ceil(3P/2)) / p.m. polynomial order
+	static inline int_t numPoint(int_t order) { return std::max(int_t(3), (3 * order + 1) / 2); }
+
 private:
 	// Quadrature variable
 	static Quadrature _quad;
+	// Points and weights of every number of points / [number of points][index]
+	std::vector<std::vector<real_t> > _X;
+	std::vector<std::vector<real_t> > _W;
+	std::vector<std::vector<real_t> > _lobattoX;
+	std::vector<std::vector<real_t> > _lobattoW;
 };
 
 // Gauss-Legendre quadrature macro
@@ -26,4 +45,12 @@ private:
 #define Gauss2_W(index) Quadrature::gauss2W(index)
 
 #define Gauss3_X(index) Quadrature::gauss3X(index)
-#define Gauss3_W(index) Quadrature::gauss3W(index)
\ No newline at end of file
+#define Gauss3_W(index) Quadrature::gauss3W(index)
+
+#define Gauss_X(num, index) Quadrature::gaussX(num, index)
+#define Gauss_W(num, index) Quadrature::gaussW(num, index)
+
+// Gauss-Lobatto quadrature macro
+// index : 0~
+#define Lobatto_X(num, index) Quadrature::gaussLobattoX(num, index)
+#define Lobatto_W(num, index) Quadrature::gaussLobattoW(num, index)
\ No newline at end of file
@@ -0,0 +1,43 @@
+#include "RHSKernel.h"
+
+RHSKernel::RHSKernel(int_t num_cell)
+{
+	_flux.resize(num_cell, 0.0);
+}
+
+RHSKernel::~RHSKernel()
+{
+
+}
+
+std::shared_ptr<RHSKernel> RHSKernel::create(int_t polyOrder, Type PDEtype, Type fluxType, int_t num_cell)
+{
+	if (fluxType == "godunov")
+	{
+		if (PDEtype == "advection") return createOrder<Advection, GodunovFlux<Advection> >(polyOrder, num_cell);
+
+		else if (PDEtype == "burgers") return createOrder<Burgers, GodunovFlux<Burgers> >(polyOrder, num_cell);
+
+		else ERROR("cannot find physical flux");
+	}
+
+	else ERROR("cannot find flux scheme");
+
+	return nullptr;
+}
+
+std::shared_ptr<RHSKernel> RHSKernel::createNodal(int_t polyOrder, Type PDEtype, Type fluxType, int_t num_cell)
+{
+	if (fluxType == "godunov")
+	{
+		if (PDEtype == "advection") return createNodalOrder<Advection, GodunovFlux<Advection> >(polyOrder, num_cell);
+
+		else if (PDEtype == "burgers") return createNodalOrder<Burgers, GodunovFlux<Burgers> >(polyOrder, num_cell);
+
+		else ERROR("cannot find physical flux");
+	}
+
+	else ERROR("cannot find flux scheme");
+
+	return nullptr;
+}
\ No newline at end of file
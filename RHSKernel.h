@@ -0,0 +1,649 @@
+#pragma once
+#include "DataType.h"
+#include "Zone.h"
+#include "FluxPolicy.h"
+#include "SIMDKernel.h"
+#include "ThreadPool.h"
+
+class RHSKernel
+{
+public:
+	// Constructor / p.m. number of cells
+	RHSKernel(int_t);
+
+	// Destructor
+	virtual ~RHSKernel();
+
+public:
+	// Functions
+	// Compute right hand side / p.m. Zone to compute, RHS(output)
+	virtual void compute(std::shared_ptr<Zone>, DOFArray&) = 0;
+
+	// Compute right hand side of cell range, faces of the range included / p.m. Zone to compute, RHS(output), begin cell, end cell(exclusive)
+	virtual void compute(std::shared_ptr<Zone>, DOFArray&, int_t, int_t) = 0;
+
+	// Numerical flux of last compute, face i is left of cell i
+	inline const std::vector<real_t>& getFlux() const { return _flux; }
+
+	// Create kernel specialized to PDE, flux scheme and polynomial order / p.m. polynomial order, Equation type, Flux type, number of cells
+	static std::shared_ptr<RHSKernel> create(int_t, Type, Type, int_t);
+
+	// Create kernel of nodal DOF on Gauss-Lobatto nodes / p.m. polynomial order, Equation type, Flux type, number of cells
+	static std::shared_ptr<RHSKernel> createNodal(int_t, Type, Type, int_t);
+
+protected:
+	// Variables
+	std::vector<real_t> _flux;
+
+protected:
+	// Functions
+	// Create kernel specialized to polynomial order / p.m. polynomial order, number of cells
+	template <typename PDE, typename Flux>
+	static std::shared_ptr<RHSKernel> createOrder(int_t, int_t);
+
+	// Create nodal kernel specialized to polynomial order / p.m. polynomial order, number of cells
+	template <typename PDE, typename Flux>
+	static std::shared_ptr<RHSKernel> createNodalOrder(int_t, int_t);
+};
+
+// RHS kernel with compile-time PDE traits, numerical flux and polynomial order P
+// Tables are modal coefficients on the reference cell [-1, 1], Q Gauss points integrate the volume term of order P exactly
+template <typename PDE, typename Flux, int_t P>
+class RHSKernelOrder : public RHSKernel
+{
+public:
+	static const int_t Q = ((3 * P + 1) / 2 > 3) ? (3 * P + 1) / 2 : 3;
+
+public:
+	// Constructor / p.m. number of cells
+	RHSKernelOrder(int_t);
+
+	// Destructor
+	virtual ~RHSKernelOrder() {}
+
+public:
+	// Functions
+	// Compute right hand side / p.m. Zone to compute, RHS(output)
+	virtual void compute(std::shared_ptr<Zone>, DOFArray&);
+
+	// Compute right hand side of cell range, faces of the range included / p.m. Zone to compute, RHS(output), begin cell, end cell(exclusive)
+	virtual void compute(std::shared_ptr<Zone>, DOFArray&, int_t, int_t);
+
+protected:
+	// Variables
+	Flux _numFlux;
+	// Vectorized sweeps, nullptr for scalar kernel
+	SweepFtn _interfaceSweep;
+	SweepFtn _volumeSweep;
+	real_t _faceLeft[P + 1]; /// solution at left face
+	real_t _faceRight[P + 1]; /// solution at right face
+	real_t _basisQuad[P + 1][Q]; /// solution at quadrature points
+	real_t _surfLeft[P + 1]; /// left face flux to RHS
+	real_t _surfRight[P + 1]; /// right face flux to RHS
+	real_t _volume[P + 1][Q]; /// physical flux at quadrature points to RHS
+
+protected:
+	// Functions
+	// Surface and volume integral of cell below order P, higher modes get zero RHS / p.m. DOF, RHS(output), interface flux, inverse cell size, cell index, order of cell
+	void reducedCell(const DOFArray&, DOFArray&, const real_t*, real_t, int_t, int_t) const;
+};
+
+template <typename PDE, typename Flux, int_t P>
+RHSKernelOrder<PDE, Flux, P>::RHSKernelOrder(int_t num_cell)
+	: RHSKernel(num_cell)
+{
+	// Vectorized sweeps of selected instruction set
+	_interfaceSweep = SIMDKernel::interfaceSweep<PDE>(SIMDKernel::getLevel(), P);
+	_volumeSweep = SIMDKernel::volumeSweep<PDE>(SIMDKernel::getLevel(), P);
+
+	for (int_t idegree = 0; idegree <= P; ++idegree)
+	{
+		real_t scale = DGbasis::legendreScale(idegree);
+		real_t sign = (idegree % 2 == 0) ? 1.0 : -1.0;
+
+		// Basis function times its coefficient is (2n+1)/scale*Legendre
+		_faceLeft[idegree] = sign*(2 * idegree + 1) / scale;
+		_faceRight[idegree] = (2 * idegree + 1) / scale;
+		_surfLeft[idegree] = sign*scale;
+		_surfRight[idegree] = -scale;
+		for (int_t iquad = 0; iquad < Q; ++iquad)
+		{
+			_basisQuad[idegree][iquad] = (2 * idegree + 1) / scale*DGbasis::legendre(idegree, Gauss_X(Q, iquad));
+			_volume[idegree][iquad] = scale*Gauss_W(Q, iquad)*DGbasis::legendreDeriv(idegree, Gauss_X(Q, iquad));
+		}
+	}
+}
+
+template <typename PDE, typename Flux, int_t P>
+void RHSKernelOrder<PDE, Flux, P>::compute(std::shared_ptr<Zone> zone, DOFArray& RHS)
+{
+	const int_t num_cell = zone->getGrid()->getNumCell();
+
+	// RHS of ghost cells stays zero
+	for (int_t icell = 0; icell < GHOST; ++icell)
+	{
+		for (int_t idegree = 0; idegree <= P; ++idegree)
+		{
+			RHS(idegree, icell) = 0.0;
+			RHS(idegree, num_cell - 1 - icell) = 0.0;
+		}
+	}
+
+	compute(zone, RHS, GHOST, num_cell - GHOST);
+}
+
+template <typename PDE, typename Flux, int_t P>
+void RHSKernelOrder<PDE, Flux, P>::compute(std::shared_ptr<Zone> zone, DOFArray& RHS, int_t first, int_t last)
+{
+	const DOFArray& DOF = zone->getDOF();
+	const real_t* inv_sizeX = zone->getGrid()->getInvSizeX().data();
+	const int_t* degree = zone->getDegree().data();
+	real_t* flux = _flux.data();
+
+	// Vectorized sweeps need contiguous cells of each mode
+	if ((P <= SIMD_MAX_ORDER) && (_interfaceSweep != nullptr) && (DOF.getLayout() == Layout::SoA))
+	{
+		SweepData data;
+		for (int_t idegree = 0; idegree <= P; ++idegree)
+		{
+			data.DOF[idegree] = DOF.mode(idegree).data();
+			data.RHS[idegree] = RHS.mode(idegree).data();
+		}
+		data.flux = flux;
+		data.faceLeft = _faceLeft;
+		data.faceRight = _faceRight;
+		data.basisQuad = &_basisQuad[0][0];
+		data.surfLeft = _surfLeft;
+		data.surfRight = _surfRight;
+		data.volume = &_volume[0][0];
+		data.inv_sizeX = inv_sizeX;
+
+		auto interfaceSweep = [&](int_t begin, int_t end) { _interfaceSweep(data, begin, end); };
+		// Runs of full-order cells are vectorized, cells of reduced order are computed one by one
+		auto volumeSweep = [&](int_t begin, int_t end)
+		{
+			int_t first = begin;
+			for (int_t icell = begin; icell < end; ++icell)
+			{
+				if (degree[icell] == P) continue;
+				if (first < icell) _volumeSweep(data, first, icell);
+				reducedCell(DOF, RHS, flux, inv_sizeX[icell], icell, degree[icell]);
+				first = icell + 1;
+			}
+			if (first < end) _volumeSweep(data, first, end);
+		};
+		ThreadPool::parallelFor(first, last + 1, interfaceSweep);
+		ThreadPool::parallelFor(first, last, volumeSweep);
+		return;
+	}
+
+	// DG flux
+	auto interfaceFlux = [&](int_t begin, int_t end)
+	{
+		for (int_t icell = begin; icell < end; ++icell)
+		{
+			// Local projection
+			real_t left_u = 0.0;
+			real_t right_u = 0.0;
+			for (int_t idegree = 0; idegree <= P; ++idegree)
+			{
+				left_u += _faceRight[idegree] * DOF(idegree, icell - 1);
+				right_u += _faceLeft[idegree] * DOF(idegree, icell);
+			}
+
+			// Calculate flux
+			flux[icell] = _numFlux(left_u, right_u);
+		}
+	};
+	ThreadPool::parallelFor(first, last + 1, interfaceFlux);
+
+	// Calculate RHS
+	auto volumeIntegral = [&](int_t begin, int_t end)
+	{
+		for (int_t icell = begin; icell < end; ++icell)
+		{
+			if (degree[icell] < P)
+			{
+				reducedCell(DOF, RHS, flux, inv_sizeX[icell], icell, degree[icell]);
+				continue;
+			}
+
+			// Physical flux at quadrature points
+			real_t phyFlux[Q] = {};
+			if (P > 0)
+			{
+				for (int_t iquad = 0; iquad < Q; ++iquad)
+				{
+					real_t u = 0.0;
+					for (int_t idegree = 0; idegree <= P; ++idegree)
+						u += _basisQuad[idegree][iquad] * DOF(idegree, icell);
+					phyFlux[iquad] = PDE::flux(u);
+				}
+			}
+
+			// Surface and volume integral
+			for (int_t idegree = 0; idegree <= P; ++idegree)
+			{
+				real_t rhs = _surfRight[idegree] * flux[icell + 1] + _surfLeft[idegree] * flux[icell];
+				if (P > 0)
+				{
+					for (int_t iquad = 0; iquad < Q; ++iquad)
+						rhs += _volume[idegree][iquad] * phyFlux[iquad];
+				}
+				RHS(idegree, icell) = inv_sizeX[icell]*rhs;
+			}
+		}
+	};
+	ThreadPool::parallelFor(first, last, volumeIntegral);
+}
+
+template <typename PDE, typename Flux, int_t P>
+void RHSKernelOrder<PDE, Flux, P>::reducedCell(const DOFArray& DOF, DOFArray& RHS, const real_t* flux, real_t inv_sizeX, int_t icell, int_t degree) const
+{
+	// Physical flux at quadrature points from nonzero modes, P0 has no volume integral
+	real_t phyFlux[Q] = {};
+	if (degree > 0)
+	{
+		for (int_t iquad = 0; iquad < Q; ++iquad)
+		{
+			real_t u = 0.0;
+			for (int_t idegree = 0; idegree <= degree; ++idegree)
+				u += _basisQuad[idegree][iquad] * DOF(idegree, icell);
+			phyFlux[iquad] = PDE::flux(u);
+		}
+	}
+
+	for (int_t idegree = 0; idegree <= degree; ++idegree)
+	{
+		real_t rhs = _surfRight[idegree] * flux[icell + 1] + _surfLeft[idegree] * flux[icell];
+		if (degree > 0)
+		{
+			for (int_t iquad = 0; iquad < Q; ++iquad)
+				rhs += _volume[idegree][iquad] * phyFlux[iquad];
+		}
+		RHS(idegree, icell) = inv_sizeX*rhs;
+	}
+	for (int_t idegree = degree + 1; idegree <= P; ++idegree)
+		RHS(idegree, icell) = 0.0;
+}
+
+// RHS kernel of polynomial order known at run time, same tables as RHSKernelOrder in dense arrays
+// Used above the orders of compile-time kernels
+template <typename PDE, typename Flux>
+class RHSKernelAnyOrder : public RHSKernel
+{
+public:
+	// Constructor / p.m. polynomial order, number of cells
+	RHSKernelAnyOrder(int_t, int_t);
+
+	// Destructor
+	virtual ~RHSKernelAnyOrder() {}
+
+public:
+	// Functions
+	// Compute right hand side / p.m. Zone to compute, RHS(output)
+	virtual void compute(std::shared_ptr<Zone>, DOFArray&);
+
+	// Compute right hand side of cell range, faces of the range included / p.m. Zone to compute, RHS(output), begin cell, end cell(exclusive)
+	virtual void compute(std::shared_ptr<Zone>, DOFArray&, int_t, int_t);
+
+protected:
+	// Variables
+	Flux _numFlux;
+	int_t _polyOrder;
+	int_t _num_quad;
+	std::vector<real_t> _faceLeft; /// [degree]
+	std::vector<real_t> _faceRight; /// [degree]
+	std::vector<real_t> _basisQuad; /// [degree][quadrature point]
+	std::vector<real_t> _surfLeft; /// [degree]
+	std::vector<real_t> _surfRight; /// [degree]
+	std::vector<real_t> _volume; /// [degree][quadrature point]
+	int_t _stride; /// work storage of one thread, padded to cache lines
+	std::vector<real_t> _phyFlux; /// [thread][quadrature point], physical flux at quadrature points
+};
+
+template <typename PDE, typename Flux>
+RHSKernelAnyOrder<PDE, Flux>::RHSKernelAnyOrder(int_t polyOrder, int_t num_cell)
+	: RHSKernel(num_cell)
+{
+	_polyOrder = polyOrder;
+	_num_quad = Quadrature::numPoint(polyOrder);
+	_faceLeft.resize(polyOrder + 1); _faceRight.resize(polyOrder + 1);
+	_surfLeft.resize(polyOrder + 1); _surfRight.resize(polyOrder + 1);
+	_basisQuad.resize((polyOrder + 1)*_num_quad); _volume.resize((polyOrder + 1)*_num_quad);
+	_stride = (_num_quad + THREAD_ALIGN - 1) / THREAD_ALIGN*THREAD_ALIGN;
+	_phyFlux.resize(THREAD_MAX*_stride);
+
+	for (int_t idegree = 0; idegree <= polyOrder; ++idegree)
+	{
+		real_t scale = DGbasis::legendreScale(idegree);
+		real_t sign = (idegree % 2 == 0) ? 1.0 : -1.0;
+		_faceLeft[idegree] = sign*(2 * idegree + 1) / scale;
+		_faceRight[idegree] = (2 * idegree + 1) / scale;
+		_surfLeft[idegree] = sign*scale;
+		_surfRight[idegree] = -scale;
+		for (int_t iquad = 0; iquad < _num_quad; ++iquad)
+		{
+			_basisQuad[idegree*_num_quad + iquad] = (2 * idegree + 1) / scale*DGbasis::legendre(idegree, Gauss_X(_num_quad, iquad));
+			_volume[idegree*_num_quad + iquad] = scale*Gauss_W(_num_quad, iquad)*DGbasis::legendreDeriv(idegree, Gauss_X(_num_quad, iquad));
+		}
+	}
+}
+
+template <typename PDE, typename Flux>
+void RHSKernelAnyOrder<PDE, Flux>::compute(std::shared_ptr<Zone> zone, DOFArray& RHS)
+{
+	const int_t num_cell = zone->getGrid()->getNumCell();
+
+	// RHS of ghost cells stays zero
+	for (int_t icell = 0; icell < GHOST; ++icell)
+	{
+		for (int_t idegree = 0; idegree <= _polyOrder; ++idegree)
+		{
+			RHS(idegree, icell) = 0.0;
+			RHS(idegree, num_cell - 1 - icell) = 0.0;
+		}
+	}
+
+	compute(zone, RHS, GHOST, num_cell - GHOST);
+}
+
+template <typename PDE, typename Flux>
+void RHSKernelAnyOrder<PDE, Flux>::compute(std::shared_ptr<Zone> zone, DOFArray& RHS, int_t first, int_t last)
+{
+	const DOFArray& DOF = zone->getDOF();
+	const real_t* inv_sizeX = zone->getGrid()->getInvSizeX().data();
+	const int_t* degree = zone->getDegree().data();
+	real_t* flux = _flux.data();
+	const int_t P = _polyOrder;
+	const int_t Q = _num_quad;
+
+	// DG flux
+	auto interfaceFlux = [&](int_t begin, int_t end)
+	{
+		for (int_t icell = begin; icell < end; ++icell)
+		{
+			real_t left_u = 0.0;
+			real_t right_u = 0.0;
+			for (int_t idegree = 0; idegree <= P; ++idegree)
+			{
+				left_u += _faceRight[idegree] * DOF(idegree, icell - 1);
+				right_u += _faceLeft[idegree] * DOF(idegree, icell);
+			}
+			flux[icell] = _numFlux(left_u, right_u);
+		}
+	};
+	ThreadPool::parallelFor(first, last + 1, interfaceFlux);
+
+	// Surface and volume integral of nonzero modes, higher modes of reduced cells get zero RHS
+	auto volumeIntegral = [&](int_t begin, int_t end)
+	{
+		real_t* phyFlux = &_phyFlux[ThreadPool::getThreadIndex()*_stride];
+		for (int_t icell = begin; icell < end; ++icell)
+		{
+			const int_t order = degree[icell];
+			for (int_t iquad = 0; iquad < Q; ++iquad)
+			{
+				real_t u = 0.0;
+				for (int_t idegree = 0; idegree <= order; ++idegree)
+					u += _basisQuad[idegree*Q + iquad] * DOF(idegree, icell);
+				phyFlux[iquad] = PDE::flux(u);
+			}
+
+			for (int_t idegree = 0; idegree <= order; ++idegree)
+			{
+				real_t rhs = _surfRight[idegree] * flux[icell + 1] + _surfLeft[idegree] * flux[icell];
+				for (int_t iquad = 0; iquad < Q; ++iquad)
+					rhs += _volume[idegree*Q + iquad] * phyFlux[iquad];
+				RHS(idegree, icell) = inv_sizeX[icell] * rhs;
+			}
+			for (int_t idegree = order + 1; idegree <= P; ++idegree)
+				RHS(idegree, icell) = 0.0;
+		}
+	};
+	ThreadPool::parallelFor(first, last, volumeIntegral);
+}
+
+template <typename PDE, typename Flux>
+std::shared_ptr<RHSKernel> RHSKernel::createOrder(int_t polyOrder, int_t num_cell)
+{
+	switch (polyOrder)
+	{
+	case 0: return std::make_shared<RHSKernelOrder<PDE, Flux, 0> >(num_cell);
+	case 1: return std::make_shared<RHSKernelOrder<PDE, Flux, 1> >(num_cell);
+	case 2: return std::make_shared<RHSKernelOrder<PDE, Flux, 2> >(num_cell);
+	case 3: return std::make_shared<RHSKernelOrder<PDE, Flux, 3> >(num_cell);
+	case 4: return std::make_shared<RHSKernelOrder<PDE, Flux, 4> >(num_cell);
+	default:
+		if (polyOrder < 0) ERROR("polynomial order");
+		return std::make_shared<RHSKernelAnyOrder<PDE, Flux> >(polyOrder, num_cell);
+	}
+}
+
+// RHS kernel of nodal DOF on P+1 Gauss-Lobatto nodes, collocated physical flux and lumped mass of the nodes
+// Face values are the end nodes, volume term is a dense (P+1)x(P+1) product with the weak differentiation matrix
+template <typename PDE, typename Flux, int_t P>
+class RHSKernelNodal : public RHSKernel
+{
+public:
+	// Constructor / p.m. number of cells
+	RHSKernelNodal(int_t);
+
+	// Destructor
+	virtual ~RHSKernelNodal() {}
+
+public:
+	// Functions
+	// Compute right hand side / p.m. Zone to compute, RHS(output)
+	virtual void compute(std::shared_ptr<Zone>, DOFArray&);
+
+	// Compute right hand side of cell range, faces of the range included / p.m. Zone to compute, RHS(output), begin cell, end cell(exclusive)
+	virtual void compute(std::shared_ptr<Zone>, DOFArray&, int_t, int_t);
+
+protected:
+	// Variables
+	Flux _numFlux;
+	real_t _surfLeft; /// left face flux to RHS of first node
+	real_t _surfRight; /// right face flux to RHS of last node
+	real_t _volume[P + 1][P + 1]; /// physical flux at nodes to RHS of nodes
+};
+
+template <typename PDE, typename Flux, int_t P>
+RHSKernelNodal<PDE, Flux, P>::RHSKernelNodal(int_t num_cell)
+	: RHSKernel(num_cell)
+{
+	// Derivative of Lagrange polynomial of node j at node k is derivative of its modal expansion
+	_surfLeft = 2.0 / Lobatto_W(P + 1, 0);
+	_surfRight = -2.0 / Lobatto_W(P + 1, P);
+	for (int_t inode = 0; inode <= P; ++inode)
+	{
+		for (int_t jnode = 0; jnode <= P; ++jnode)
+		{
+			real_t deriv = 0.0;
+			for (int_t idegree = 0; idegree <= P; ++idegree)
+				deriv += (2 * idegree + 1) / DGbasis::legendreScale(idegree)*DGbasis::legendreDeriv(idegree, Lobatto_X(P + 1, jnode))*DGbasis::nodeToMode(P, idegree, inode);
+			_volume[inode][jnode] = 2.0*Lobatto_W(P + 1, jnode)*deriv / Lobatto_W(P + 1, inode);
+		}
+	}
+}
+
+template <typename PDE, typename Flux, int_t P>
+void RHSKernelNodal<PDE, Flux, P>::compute(std::shared_ptr<Zone> zone, DOFArray& RHS)
+{
+	const int_t num_cell = zone->getGrid()->getNumCell();
+
+	// RHS of ghost cells stays zero
+	for (int_t icell = 0; icell < GHOST; ++icell)
+	{
+		for (int_t inode = 0; inode <= P; ++inode)
+		{
+			RHS(inode, icell) = 0.0;
+			RHS(inode, num_cell - 1 - icell) = 0.0;
+		}
+	}
+
+	compute(zone, RHS, GHOST, num_cell - GHOST);
+}
+
+template <typename PDE, typename Flux, int_t P>
+void RHSKernelNodal<PDE, Flux, P>::compute(std::shared_ptr<Zone> zone, DOFArray& RHS, int_t first, int_t last)
+{
+	const DOFArray& DOF = zone->getDOF();
+	const real_t* inv_sizeX = zone->getGrid()->getInvSizeX().data();
+	real_t* flux = _flux.data();
+
+	// DG flux of end nodes
+	auto interfaceFlux = [&](int_t begin, int_t end)
+	{
+		for (int_t icell = begin; icell < end; ++icell)
+			flux[icell] = _numFlux(DOF(P, icell - 1), DOF(0, icell));
+	};
+	ThreadPool::parallelFor(first, last + 1, interfaceFlux);
+
+	// Surface and volume integral
+	auto volumeIntegral = [&](int_t begin, int_t end)
+	{
+		for (int_t icell = begin; icell < end; ++icell)
+		{
+			real_t phyFlux[P + 1];
+			for (int_t jnode = 0; jnode <= P; ++jnode)
+				phyFlux[jnode] = PDE::flux(DOF(jnode, icell));
+
+			for (int_t inode = 0; inode <= P; ++inode)
+			{
+				real_t rhs = 0.0;
+				for (int_t jnode = 0; jnode <= P; ++jnode)
+					rhs += _volume[inode][jnode] * phyFlux[jnode];
+				if (inode == 0) rhs += _surfLeft*flux[icell];
+				if (inode == P) rhs += _surfRight*flux[icell + 1];
+				RHS(inode, icell) = inv_sizeX[icell] * rhs;
+			}
+		}
+	};
+	ThreadPool::parallelFor(first, last, volumeIntegral);
+}
+
+// Nodal RHS kernel of polynomial order known at run time, same tables as RHSKernelNodal in dense arrays
+template <typename PDE, typename Flux>
+class RHSKernelNodalAnyOrder : public RHSKernel
+{
+public:
+	// Constructor / p.m. polynomial order, number of cells
+	RHSKernelNodalAnyOrder(int_t, int_t);
+
+	// Destructor
+	virtual ~RHSKernelNodalAnyOrder() {}
+
+public:
+	// Functions
+	// Compute right hand side / p.m. Zone to compute, RHS(output)
+	virtual void compute(std::shared_ptr<Zone>, DOFArray&);
+
+	// Compute right hand side of cell range, faces of the range included / p.m. Zone to compute, RHS(output), begin cell, end cell(exclusive)
+	virtual void compute(std::shared_ptr<Zone>, DOFArray&, int_t, int_t);
+
+protected:
+	// Variables
+	Flux _numFlux;
+	int_t _polyOrder;
+	real_t _surfLeft; /// left face flux to RHS of first node
+	real_t _surfRight; /// right face flux to RHS of last node
+	std::vector<real_t> _volume; /// [node][node]
+	int_t _stride; /// work storage of one thread, padded to cache lines
+	std::vector<real_t> _phyFlux; /// [thread][node], physical flux at nodes
+};
+
+template <typename PDE, typename Flux>
+RHSKernelNodalAnyOrder<PDE, Flux>::RHSKernelNodalAnyOrder(int_t polyOrder, int_t num_cell)
+	: RHSKernel(num_cell)
+{
+	const int_t P = polyOrder;
+	_polyOrder = polyOrder;
+	_surfLeft = 2.0 / Lobatto_W(P + 1, 0);
+	_surfRight = -2.0 / Lobatto_W(P + 1, P);
+	_volume.resize((P + 1)*(P + 1));
+	_stride = (P + THREAD_ALIGN) / THREAD_ALIGN*THREAD_ALIGN;
+	_phyFlux.resize(THREAD_MAX*_stride);
+	for (int_t inode = 0; inode <= P; ++inode)
+	{
+		for (int_t jnode = 0; jnode <= P; ++jnode)
+		{
+			real_t deriv = 0.0;
+			for (int_t idegree = 0; idegree <= P; ++idegree)
+				deriv += (2 * idegree + 1) / DGbasis::legendreScale(idegree)*DGbasis::legendreDeriv(idegree, Lobatto_X(P + 1, jnode))*DGbasis::nodeToMode(P, idegree, inode);
+			_volume[inode*(P + 1) + jnode] = 2.0*Lobatto_W(P + 1, jnode)*deriv / Lobatto_W(P + 1, inode);
+		}
+	}
+}
+
+template <typename PDE, typename Flux>
+void RHSKernelNodalAnyOrder<PDE, Flux>::compute(std::shared_ptr<Zone> zone, DOFArray& RHS)
+{
+	const int_t num_cell = zone->getGrid()->getNumCell();
+
+	// RHS of ghost cells stays zero
+	for (int_t icell = 0; icell < GHOST; ++icell)
+	{
+		for (int_t inode = 0; inode <= _polyOrder; ++inode)
+		{
+			RHS(inode, icell) = 0.0;
+			RHS(inode, num_cell - 1 - icell) = 0.0;
+		}
+	}
+
+	compute(zone, RHS, GHOST, num_cell - GHOST);
+}
+
+template <typename PDE, typename Flux>
+void RHSKernelNodalAnyOrder<PDE, Flux>::compute(std::shared_ptr<Zone> zone, DOFArray& RHS, int_t first, int_t last)
+{
+	const DOFArray& DOF = zone->getDOF();
+	const real_t* inv_sizeX = zone->getGrid()->getInvSizeX().data();
+	real_t* flux = _flux.data();
+	const int_t P = _polyOrder;
+
+	// DG flux of end nodes
+	auto interfaceFlux = [&](int_t begin, int_t end)
+	{
+		for (int_t icell = begin; icell < end; ++icell)
+			flux[icell] = _numFlux(DOF(P, icell - 1), DOF(0, icell));
+	};
+	ThreadPool::parallelFor(first, last + 1, interfaceFlux);
+
+	// Surface and volume integral
+	auto volumeIntegral = [&](int_t begin, int_t end)
+	{
+		real_t* phyFlux = &_phyFlux[ThreadPool::getThreadIndex()*_stride];
+		for (int_t icell = begin; icell < end; ++icell)
+		{
+			for (int_t jnode = 0; jnode <= P; ++jnode)
+				phyFlux[jnode] = PDE::flux(DOF(jnode, icell));
+
+			for (int_t inode = 0; inode <= P; ++inode)
+			{
+				real_t rhs = 0.0;
+				for (int_t jnode = 0; jnode <= P; ++jnode)
+					rhs += _volume[inode*(P + 1) + jnode] * phyFlux[jnode];
+				if (inode == 0) rhs += _surfLeft*flux[icell];
+				if (inode == P) rhs += _surfRight*flux[icell + 1];
+				RHS(inode, icell) = inv_sizeX[icell] * rhs;
+			}
+		}
+	};
+	ThreadPool::parallelFor(first, last, volumeIntegral);
+}
+
+template <typename PDE, typename Flux>
+std::shared_ptr<RHSKernel> RHSKernel::createNodalOrder(int_t polyOrder, int_t num_cell)
+{
+	switch (polyOrder)
+	{
+	case 1: return std::make_shared<RHSKernelNodal<PDE, Flux, 1> >(num_cell);
+	case 2: return std::make_shared<RHSKernelNodal<PDE, Flux, 2> >(num_cell);
+	case 3: return std::make_shared<RHSKernelNodal<PDE, Flux, 3> >(num_cell);
+	case 4: return std::make_shared<RHSKernelNodal<PDE, Flux, 4> >(num_cell);
+	default:
+		if (polyOrder < 1) ERROR("nodal basis needs polynomial order 1 or higher");
+		return std::make_shared<RHSKernelNodalAnyOrder<PDE, Flux> >(polyOrder, num_cell);
+	}
+}
\ No newline at end of file
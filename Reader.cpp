@@ -1,10 +1,30 @@
 #include "Reader.h"
+#include "Decomposition.h"
+#include <sstream>
+#include <cctype>
 
 Reader::Reader()
 {
 	_PDE = _initial = _boundary = _timeInteg = "";
+	_DOFlayout = "SoA";
+	_basis = "modal";
+	_SIMD = "auto";
+	_outputFormat = "plt";
 	_polyOrder = 0;
+	_numThread = 1;
+	_numOutputBuffer = 2;
+	_checkpointStep = 0;
+	_checkpointWallTime = 0.0;
+	_adaptiveOrder = "off";
+	_LTSLevel = 4;
+	_AMRLevel = 0;
+	_AMRInterval = 10;
+	_ensembleFile = "";
+	_ensembleWidth = 4;
 	_advSpeed = _area = _sizeX = _CFL = _T = 0.0;
+	_gridType = "uniform";
+	_gridStretch = 1.0;
+	_gridFile = "";
 }
 
 Reader::~Reader()
@@ -18,16 +38,26 @@ bool Reader::readFile(std::string name)
 	file.open(name);
 	bool file_open = file.is_open();
 
-	// Clear stream state
-	file.clear();
+	// Whole input text, kept for checkpoint
+	std::stringstream input;
+	if (file_open) input << file.rdbuf();
+	file.close();
+	readText(input.str());
 
-	// Read file
-	while (file.is_open())
+	return file_open;
+}
+
+void Reader::readText(const std::string& input)
+{
+	_input = input;
+	std::istringstream stream(input);
+
+	// Read text
+	std::string text;
+	while (std::getline(stream, text))
 	{
-		// Read text
-		std::string text;
-		std::getline(file, text);
-		text.erase(std::remove(text.begin(), text.end(), ' '), text.end());
+		// Spaces, tabs and carriage returns of CRLF files
+		text.erase(std::remove_if(text.begin(), text.end(), [](unsigned char c) { return std::isspace(c) != 0; }), text.end());
 
 		// Read PDE type
 		if (text.find("$$PDETYPE=", 0) != std::string::npos)
@@ -53,6 +83,48 @@ bool Reader::readFile(std::string name)
 		if (text.find("$$TIMEINTEGRATION=", 0) != std::string::npos)
 			_timeInteg = text.substr(18);
 
+		// Read levels of local time steps
+		if (text.find("$$LTSLEVELS=", 0) != std::string::npos)
+			_LTSLevel = std::stoi(text.substr(12));
+
+		// Read DOF memory layout
+		if (text.find("$$DOFLAYOUT=", 0) != std::string::npos)
+			_DOFlayout = text.substr(12);
+
+		// Read DOF representation
+		if (text.find("$$BASIS=", 0) != std::string::npos)
+			_basis = text.substr(8);
+
+		// Read SIMD instruction set
+		if (text.find("$$SIMD=", 0) != std::string::npos)
+			_SIMD = text.substr(7);
+
+		// Read output format of DG solution
+		if (text.find("$$OUTPUTFORMAT=", 0) != std::string::npos)
+			_outputFormat = text.substr(15);
+
+		// Read number of asynchronous output buffers
+		if (text.find("$$OUTPUTBUFFERS=", 0) != std::string::npos)
+			_numOutputBuffer = std::stoi(text.substr(16));
+
+		// Read checkpoint intervals
+		if (text.find("$$CHECKPOINTSTEPS=", 0) != std::string::npos)
+			_checkpointStep = std::stoi(text.substr(18));
+		if (text.find("$$CHECKPOINTWALLTIME=", 0) != std::string::npos)
+			_checkpointWallTime = std::stod(text.substr(21));
+
+		// Read adaptive order of cells
+		if (text.find("$$ADAPTIVEORDER=", 0) != std::string::npos)
+			_adaptiveOrder = text.substr(16);
+
+		// Read maximum refinement level of adaptive grid
+		if (text.find("$$AMRLEVELS=", 0) != std::string::npos)
+			_AMRLevel = std::stoi(text.substr(12));
+
+		// Read remesh interval of adaptive grid
+		if (text.find("$$AMRINTERVAL=", 0) != std::string::npos)
+			_AMRInterval = std::stoi(text.substr(14));
+
 		// Read target time
 		if (text.find("$$TARGETTIME=", 0) != std::string::npos)
 			_T = std::stod(text.substr(13));
@@ -65,6 +137,28 @@ bool Reader::readFile(std::string name)
 		if (text.find("$$GRIDSIZE=", 0) != std::string::npos)
 			_sizeX = std::stod(text.substr(11));
 
+		// Read grid type
+		if (text.find("$$GRIDTYPE=", 0) != std::string::npos)
+			_gridType = text.substr(11);
+
+		// Read stretching ratio of grid
+		if (text.find("$$GRIDSTRETCH=", 0) != std::string::npos)
+			_gridStretch = std::stod(text.substr(14));
+
+		// Read clustered region of grid
+		if (text.find("$$GRIDCLUSTER=", 0) != std::string::npos)
+		{
+			std::istringstream list(text.substr(14));
+			std::string item;
+			_gridCluster.clear();
+			while (std::getline(list, item, ','))
+				if (item != "") _gridCluster.push_back(std::stod(item));
+		}
+
+		// Read node file of grid
+		if (text.find("$$GRIDFILE=", 0) != std::string::npos)
+			_gridFile = text.substr(11);
+
 		// Read target time
 		if (text.find("$$CFL=", 0) != std::string::npos)
 			_CFL = std::stod(text.substr(6));
@@ -73,18 +167,46 @@ bool Reader::readFile(std::string name)
 		if (text.find("$$POLYNOMIALORDER=", 0) != std::string::npos)
 			_polyOrder = std::stoi(text.substr(18));
 
+		// Read number of threads
+		if (text.find("$$THREADS=", 0) != std::string::npos)
+			_numThread = std::stoi(text.substr(10));
+
+		// Read ensemble cases file
+		if (text.find("$$ENSEMBLE=", 0) != std::string::npos)
+			_ensembleFile = text.substr(11);
+
+		// Read ensemble batch width
+		if (text.find("$$ENSEMBLEWIDTH=", 0) != std::string::npos)
+			_ensembleWidth = std::stoi(text.substr(16));
+
+		// Read grid sizes of convergence test
+		if (text.find("$$CONVERGENCEGRIDSIZE=", 0) != std::string::npos)
+		{
+			std::istringstream list(text.substr(22));
+			std::string item;
+			_convSizeX.clear();
+			while (std::getline(list, item, ','))
+				if (item != "") _convSizeX.push_back(std::stod(item));
+		}
+
+		// Read polynomial orders of convergence test
+		if (text.find("$$CONVERGENCEORDER=", 0) != std::string::npos)
+		{
+			std::istringstream list(text.substr(19));
+			std::string item;
+			_convOrder.clear();
+			while (std::getline(list, item, ','))
+				if (item != "") _convOrder.push_back(std::stoi(item));
+		}
+
 		// Read advection speed
 		if (_PDE == "advection")
 			if (text.find("$$ADVECTIONSPEED=", 0) != std::string::npos)
 				_advSpeed = std::stod(text.substr(17));
-
-		if (file.eof()) file.close();
 	}
 
 	// Print conditions
-	print();
-
-	return file_open;
+	if (Decomposition::isRoot()) print();
 }
 
 void Reader::print() const
@@ -98,10 +220,51 @@ void Reader::print() const
 	std::cout << "$$ Initial condition   : " << _initial << "\n";
 	std::cout << "$$ Boundary condition  : " << _boundary << "\n";
 	std::cout << "$$ Time integration    : " << _timeInteg << "\n";
+	if (_timeInteg == "LTS-RK3")
+		std::cout << "$$ Local time steps    : " << _LTSLevel << " levels\n";
+	std::cout << "$$ DOF layout          : " << _DOFlayout << "\n";
+	std::cout << "$$ Basis               : " << _basis << "\n";
+	std::cout << "$$ SIMD                : " << _SIMD << "\n";
+	std::cout << "$$ Output format       : " << _outputFormat << "\n";
+	std::cout << "$$ Output buffers      : " << _numOutputBuffer << "\n";
+	if ((_checkpointStep > 0) || (_checkpointWallTime > 0.0))
+		std::cout << "$$ Checkpoint interval : " << _checkpointStep << " steps, " << _checkpointWallTime << " s\n";
 	std::cout << "$$ Area                : " << _area << "\n";
 	std::cout << "$$ Grid size           : " << _sizeX << "\n";
+	if (_gridType != "uniform")
+		std::cout << "$$ Grid type           : " << _gridType << "\n";
+	if (_gridType == "stretched")
+		std::cout << "$$ Grid stretch        : " << _gridStretch << "\n";
+	if (_gridType == "clustered")
+	{
+		std::cout << "$$ Grid cluster        :";
+		for (size_t ipar = 0; ipar < _gridCluster.size(); ++ipar) std::cout << " " << _gridCluster[ipar];
+		std::cout << "\n";
+	}
+	if (_gridType == "file")
+		std::cout << "$$ Grid file           : " << _gridFile << "\n";
+	if (_adaptiveOrder != "off")
+		std::cout << "$$ Adaptive order      : " << _adaptiveOrder << "\n";
+	if (_AMRLevel > 0)
+		std::cout << "$$ Adaptive grid       : " << _AMRLevel << " levels, every " << _AMRInterval << " steps\n";
 	std::cout << "$$ Target time         : " << _T << "\n";
 	std::cout << "$$ CFL number          : " << _CFL << "\n";
 	std::cout << "$$ Order of polynomial : " << _polyOrder << "\n";
+	std::cout << "$$ Threads             : " << _numThread << "\n";
+	if (!_convSizeX.empty())
+	{
+		std::cout << "$$ Convergence grids   :";
+		for (size_t isize = 0; isize < _convSizeX.size(); ++isize) std::cout << " " << _convSizeX[isize];
+		std::cout << "\n";
+		std::cout << "$$ Convergence orders  :";
+		if (_convOrder.empty()) std::cout << " " << _polyOrder;
+		for (size_t iorder = 0; iorder < _convOrder.size(); ++iorder) std::cout << " " << _convOrder[iorder];
+		std::cout << "\n";
+	}
+	if (_ensembleFile != "")
+	{
+		std::cout << "$$ Ensemble            : " << _ensembleFile << "\n";
+		std::cout << "$$ Ensemble width      : " << _ensembleWidth << "\n";
+	}
 	std::cout << "------------------------------\n";
 }
\ No newline at end of file
@@ -24,21 +24,66 @@ public:
 
 	inline Type getTimeInteg() const { return _timeInteg; }
 
+	inline int_t getLTSLevel() const { return _LTSLevel; }
+
+	inline Type getDOFLayout() const { return _DOFlayout; }
+
+	inline Type getBasis() const { return _basis; }
+
+	inline Type getSIMD() const { return _SIMD; }
+
+	inline Type getOutputFormat() const { return _outputFormat; }
+
+	inline int_t getNumOutputBuffer() const { return _numOutputBuffer; }
+
+	inline int_t getCheckpointStep() const { return _checkpointStep; }
+
+	inline real_t getCheckpointWallTime() const { return _checkpointWallTime; }
+
+	inline Type getAdaptiveOrder() const { return _adaptiveOrder; }
+
+	inline int_t getAMRLevel() const { return _AMRLevel; }
+
+	inline int_t getAMRInterval() const { return _AMRInterval; }
+
 	inline int_t getPolyOrder() const { return _polyOrder; }
 
+	inline int_t getNumThread() const { return _numThread; }
+
+	inline Type getEnsembleFile() const { return _ensembleFile; }
+
+	inline int_t getEnsembleWidth() const { return _ensembleWidth; }
+
+	inline const std::vector<real_t>& getConvSizeX() const { return _convSizeX; }
+
+	inline const std::vector<int_t>& getConvOrder() const { return _convOrder; }
+
 	inline real_t getAdvSpeed() const { return _advSpeed; }
 
 	inline real_t getArea() const { return _area; }
 
 	inline real_t getSizeX() const { return _sizeX; }
 
+	inline Type getGridType() const { return _gridType; }
+
+	inline real_t getGridStretch() const { return _gridStretch; }
+
+	inline const std::vector<real_t>& getGridCluster() const { return _gridCluster; }
+
+	inline Type getGridFile() const { return _gridFile; }
+
 	inline real_t getCFL() const { return _CFL; }
 
 	inline real_t getTargetT() const { return _T; }
 
+	inline const std::string& getInput() const { return _input; }
+
 	// Read file / p.m. file name / r.t. true/false
 	bool readFile(std::string);
 
+	// Read input text, same format as file / p.m. input text
+	void readText(const std::string&);
+
 protected:
 	// Variables
 	Type _PDE;
@@ -47,12 +92,33 @@ protected:
 	Type _initial;
 	Type _boundary;
 	Type _timeInteg;
+	int_t _LTSLevel; /// levels of local time steps
+	Type _DOFlayout;
+	Type _basis; /// modal, nodal : values at Gauss-Lobatto nodes
+	Type _SIMD;
+	Type _outputFormat;
 	int_t _polyOrder;
+	int_t _numThread;
+	int_t _numOutputBuffer;
+	int_t _checkpointStep; /// step interval of checkpoint, 0 : off
+	real_t _checkpointWallTime; /// wall-clock interval of checkpoint in seconds, 0 : off
+	Type _adaptiveOrder; /// on : order of cells follows hMLP, off
+	int_t _AMRLevel; /// maximum refinement level of adaptive grid, 0 : off
+	int_t _AMRInterval; /// remesh interval in steps
+	Type _ensembleFile;
+	int_t _ensembleWidth;
+	std::vector<real_t> _convSizeX; /// grid sizes of convergence test
+	std::vector<int_t> _convOrder; /// polynomial orders of convergence test
 	real_t _advSpeed;
 	real_t _area;
 	real_t _sizeX;
+	Type _gridType; /// uniform, stretched, clustered, file
+	real_t _gridStretch; /// ratio of neighboring cells of stretched grid
+	std::vector<real_t> _gridCluster; /// begin, end, refinement factor of clustered grid
+	Type _gridFile; /// node file of file grid
 	real_t _CFL;
 	real_t _T;
+	std::string _input; /// input text
 
 protected:
 	// Functions
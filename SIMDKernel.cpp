@@ -0,0 +1,243 @@
+#include "SIMDKernel.h"
+#include "FluxPolicy.h"
+
+#if defined(__x86_64__) || defined(_M_X64)
+#define SIMD_X86
+#include <immintrin.h>
+#ifdef _MSC_VER
+#include <intrin.h>
+#endif
+#endif
+
+SIMDKernel::SIMDKernel()
+{
+	_level = SIMDLevel::Scalar;
+}
+
+SIMDKernel::~SIMDKernel()
+{
+
+}
+
+// One lane, used for remainder cells
+namespace scalar
+{
+	struct Vec
+	{
+		static const int_t width = 1;
+		real_t v;
+
+		static inline Vec zero() { Vec a; a.v = 0.0; return a; }
+		static inline Vec set1(real_t x) { Vec a; a.v = x; return a; }
+		static inline Vec load(const real_t* ptr) { Vec a; a.v = *ptr; return a; }
+		static inline void store(real_t* ptr, Vec a) { *ptr = a.v; }
+		static inline Vec add(Vec a, Vec b) { Vec c; c.v = a.v + b.v; return c; }
+		static inline Vec mul(Vec a, Vec b) { Vec c; c.v = a.v * b.v; return c; }
+		static inline Vec max(Vec a, Vec b) { Vec c; c.v = std::max(a.v, b.v); return c; }
+		static inline Vec min(Vec a, Vec b) { Vec c; c.v = std::min(a.v, b.v); return c; }
+	};
+
+#include "SIMDSweep.h"
+}
+
+#ifdef SIMD_X86
+// FMA contraction is disabled to keep the scalar summation order
+#ifdef __GNUC__
+#pragma GCC push_options
+#pragma GCC target("avx2")
+#pragma GCC optimize("fp-contract=off")
+#endif
+namespace avx2
+{
+	struct Vec
+	{
+		static const int_t width = 4;
+		__m256d v;
+
+		static inline Vec zero() { Vec a; a.v = _mm256_setzero_pd(); return a; }
+		static inline Vec set1(real_t x) { Vec a; a.v = _mm256_set1_pd(x); return a; }
+		static inline Vec load(const real_t* ptr) { Vec a; a.v = _mm256_loadu_pd(ptr); return a; }
+		static inline void store(real_t* ptr, Vec a) { _mm256_storeu_pd(ptr, a.v); }
+		static inline Vec add(Vec a, Vec b) { Vec c; c.v = _mm256_add_pd(a.v, b.v); return c; }
+		static inline Vec mul(Vec a, Vec b) { Vec c; c.v = _mm256_mul_pd(a.v, b.v); return c; }
+		static inline Vec max(Vec a, Vec b) { Vec c; c.v = _mm256_max_pd(a.v, b.v); return c; }
+		static inline Vec min(Vec a, Vec b) { Vec c; c.v = _mm256_min_pd(a.v, b.v); return c; }
+	};
+
+#include "SIMDSweep.h"
+}
+#ifdef __GNUC__
+#pragma GCC pop_options
+#endif
+
+#ifdef __GNUC__
+#pragma GCC push_options
+#pragma GCC target("avx512f")
+#pragma GCC optimize("fp-contract=off")
+#endif
+namespace avx512
+{
+	struct Vec
+	{
+		static const int_t width = 8;
+		__m512d v;
+
+		static inline Vec zero() { Vec a; a.v = _mm512_setzero_pd(); return a; }
+		static inline Vec set1(real_t x) { Vec a; a.v = _mm512_set1_pd(x); return a; }
+		static inline Vec load(const real_t* ptr) { Vec a; a.v = _mm512_loadu_pd(ptr); return a; }
+		static inline void store(real_t* ptr, Vec a) { _mm512_storeu_pd(ptr, a.v); }
+		static inline Vec add(Vec a, Vec b) { Vec c; c.v = _mm512_add_pd(a.v, b.v); return c; }
+		static inline Vec mul(Vec a, Vec b) { Vec c; c.v = _mm512_mul_pd(a.v, b.v); return c; }
+		static inline Vec max(Vec a, Vec b) { Vec c; c.v = _mm512_max_pd(a.v, b.v); return c; }
+		static inline Vec min(Vec a, Vec b) { Vec c; c.v = _mm512_min_pd(a.v, b.v); return c; }
+	};
+
+#include "SIMDSweep.h"
+}
+#ifdef __GNUC__
+#pragma GCC pop_options
+#endif
+#endif
+
+// Full sweeps : vector lanes then remainder cells
+#ifdef SIMD_X86
+template <typename PDE, int_t P>
+static void interfaceSweepAVX2(const SweepData& data, int_t begin, int_t end)
+{
+	scalar::interfaceSweep<PDE, P>(data, avx2::interfaceSweep<PDE, P>(data, begin, end), end);
+}
+
+template <typename PDE, int_t P>
+static void volumeSweepAVX2(const SweepData& data, int_t begin, int_t end)
+{
+	scalar::volumeSweep<PDE, P>(data, avx2::volumeSweep<PDE, P>(data, begin, end), end);
+}
+
+template <typename PDE, int_t P>
+static void interfaceSweepAVX512(const SweepData& data, int_t begin, int_t end)
+{
+	scalar::interfaceSweep<PDE, P>(data, avx512::interfaceSweep<PDE, P>(data, begin, end), end);
+}
+
+template <typename PDE, int_t P>
+static void volumeSweepAVX512(const SweepData& data, int_t begin, int_t end)
+{
+	scalar::volumeSweep<PDE, P>(data, avx512::volumeSweep<PDE, P>(data, begin, end), end);
+}
+#endif
+
+SIMDLevel SIMDKernel::detect()
+{
+#if defined(SIMD_X86) && defined(_MSC_VER)
+	int info[4];
+	__cpuid(info, 0);
+	if (info[0] < 7) return SIMDLevel::Scalar;
+
+	// OS saves YMM/ZMM registers
+	__cpuid(info, 1);
+	if ((info[2] & (1 << 27)) == 0) return SIMDLevel::Scalar;
+	unsigned long long xcr0 = _xgetbv(0);
+
+	__cpuidex(info, 7, 0);
+	if ((info[1] & (1 << 16)) && ((xcr0 & 0xe6) == 0xe6)) return SIMDLevel::AVX512;
+	if ((info[1] & (1 << 5)) && ((xcr0 & 0x6) == 0x6)) return SIMDLevel::AVX2;
+	return SIMDLevel::Scalar;
+#elif defined(SIMD_X86) && defined(__GNUC__)
+	__builtin_cpu_init();
+	if (__builtin_cpu_supports("avx512f")) return SIMDLevel::AVX512;
+	if (__builtin_cpu_supports("avx2")) return SIMDLevel::AVX2;
+	return SIMDLevel::Scalar;
+#else
+	return SIMDLevel::Scalar;
+#endif
+}
+
+SIMDLevel SIMDKernel::select(const Type& option)
+{
+	SIMDLevel best = detect();
+
+	if (option == "auto") return best;
+
+	else if (option == "scalar") return SIMDLevel::Scalar;
+
+	else if (option == "avx2")
+	{
+		if (best == SIMDLevel::Scalar) ERROR("AVX2 is not supported");
+		return SIMDLevel::AVX2;
+	}
+
+	else if (option == "avx512")
+	{
+		if (best != SIMDLevel::AVX512) ERROR("AVX-512 is not supported");
+		return SIMDLevel::AVX512;
+	}
+
+	ERROR("cannot find SIMD option");
+	return SIMDLevel::Scalar;
+}
+
+template <typename PDE>
+SweepFtn SIMDKernel::interfaceSweep(SIMDLevel level, int_t polyOrder)
+{
+	if (level == SIMDLevel::Scalar) return nullptr;
+
+#ifdef SIMD_X86
+	if (level == SIMDLevel::AVX512)
+	{
+		switch (polyOrder)
+		{
+		case 0: return &interfaceSweepAVX512<PDE, 0>;
+		case 1: return &interfaceSweepAVX512<PDE, 1>;
+		case 2: return &interfaceSweepAVX512<PDE, 2>;
+		default: return nullptr;
+		}
+	}
+
+	switch (polyOrder)
+	{
+	case 0: return &interfaceSweepAVX2<PDE, 0>;
+	case 1: return &interfaceSweepAVX2<PDE, 1>;
+	case 2: return &interfaceSweepAVX2<PDE, 2>;
+	default: return nullptr;
+	}
+#else
+	return nullptr;
+#endif
+}
+
+template <typename PDE>
+SweepFtn SIMDKernel::volumeSweep(SIMDLevel level, int_t polyOrder)
+{
+	if (level == SIMDLevel::Scalar) return nullptr;
+
+#ifdef SIMD_X86
+	if (level == SIMDLevel::AVX512)
+	{
+		switch (polyOrder)
+		{
+		case 0: return &volumeSweepAVX512<PDE, 0>;
+		case 1: return &volumeSweepAVX512<PDE, 1>;
+		case 2: return &volumeSweepAVX512<PDE, 2>;
+		default: return nullptr;
+		}
+	}
+
+	switch (polyOrder)
+	{
+	case 0: return &volumeSweepAVX2<PDE, 0>;
+	case 1: return &volumeSweepAVX2<PDE, 1>;
+	case 2: return &volumeSweepAVX2<PDE, 2>;
+	default: return nullptr;
+	}
+#else
+	return nullptr;
+#endif
+}
+
+template SweepFtn SIMDKernel::interfaceSweep<Advection>(SIMDLevel, int_t);
+template SweepFtn SIMDKernel::interfaceSweep<Burgers>(SIMDLevel, int_t);
+template SweepFtn SIMDKernel::volumeSweep<Advection>(SIMDLevel, int_t);
+template SweepFtn SIMDKernel::volumeSweep<Burgers>(SIMDLevel, int_t);
+
+SIMDLevel SIMDKernel::_level;
+SIMDKernel SIMDKernel::_simd;
\ No newline at end of file
@@ -0,0 +1,68 @@
+#pragma once
+#include "DataType.h"
+
+// Instruction set of vectorized kernels
+enum class SIMDLevel { Scalar, AVX2, AVX512 };
+
+// Maximum polynomial order with vectorized kernels
+#define SIMD_MAX_ORDER 2
+
+// Arrays and reference tables of one RHS evaluation (SoA layout only)
+struct SweepData
+{
+	const real_t* DOF[SIMD_MAX_ORDER + 1]; /// cell 0 of each mode
+	real_t* RHS[SIMD_MAX_ORDER + 1]; /// cell 0 of each mode
+	real_t* flux; /// interface flux, flux[icell] at left face of icell
+	const real_t* faceLeft; /// [degree]
+	const real_t* faceRight; /// [degree]
+	const real_t* basisQuad; /// [degree][QuadDegree]
+	const real_t* surfLeft; /// [degree]
+	const real_t* surfRight; /// [degree]
+	const real_t* volume; /// [degree][QuadDegree]
+	const real_t* inv_sizeX; /// inverse size of every cell
+};
+
+// Sweep over a cell range / p.m. data, begin cell, end cell(exclusive)
+typedef void(*SweepFtn)(const SweepData&, int_t, int_t);
+
+// Vectorized interface-flux and volume-integral sweeps
+// Lanes hold 4(AVX2) or 8(AVX-512) consecutive cells, remainder cells run the same algorithm on one lane.
+// Godunov flux is branchless : advection max(a,0)uL + min(a,0)uR, Burgers max(f(max(uL,0)), f(min(uR,0))).
+// Tolerance against the scalar RHS kernel :
+//  - advection : bitwise identical (no FMA contraction, same summation order)
+//  - Burgers   : identical except at interfaces with |uL - uR| <= epsilon,
+//                where the flux differs by at most max(|uL|,|uR|)*epsilon
+class SIMDKernel
+{
+protected:
+	SIMDKernel();
+	~SIMDKernel();
+
+public:
+	// Best instruction set supported by CPU and OS
+	static SIMDLevel detect();
+
+	// Instruction set from input option / p.m. auto, avx512, avx2, scalar
+	static SIMDLevel select(const Type&);
+
+	// Instruction set used by RHS kernels
+	static void setLevel(SIMDLevel level) { _level = level; }
+
+	static SIMDLevel getLevel() { return _level; }
+
+	// Interface flux sweep / p.m. instruction set, polynomial order / r.t. nullptr if not vectorized
+	template <typename PDE>
+	static SweepFtn interfaceSweep(SIMDLevel, int_t);
+
+	// Volume integral sweep / p.m. instruction set, polynomial order / r.t. nullptr if not vectorized
+	template <typename PDE>
+	static SweepFtn volumeSweep(SIMDLevel, int_t);
+
+protected:
+	// Instruction set used by RHS kernels
+	static SIMDLevel _level;
+
+private:
+	// SIMDKernel variable
+	static SIMDKernel _simd;
+};
\ No newline at end of file
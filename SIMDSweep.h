@@ -0,0 +1,90 @@
+// Vectorized sweeps on a lane type Vec
+// Included once per instruction set by SIMDKernel.cpp, inside a namespace that defines Vec with
+// width, zero, set1, load, store, add, mul, max, min
+
+// Branchless Godunov flux and physical flux on lanes
+template <typename PDE>
+struct VecFlux;
+
+template <>
+struct VecFlux<Advection>
+{
+	static inline Vec phyFlux(Vec u) { return Vec::mul(Vec::set1(GET_SPEED), u); }
+
+	static inline Vec godunov(Vec left_u, Vec right_u)
+	{
+		real_t speed = GET_SPEED;
+		return Vec::add(Vec::mul(Vec::set1(std::max(speed, 0.0)), left_u), Vec::mul(Vec::set1(std::min(speed, 0.0)), right_u));
+	}
+};
+
+template <>
+struct VecFlux<Burgers>
+{
+	static inline Vec phyFlux(Vec u) { return Vec::mul(Vec::mul(Vec::set1(0.5), u), u); }
+
+	static inline Vec godunov(Vec left_u, Vec right_u)
+	{
+		Vec zero = Vec::zero();
+		return Vec::max(phyFlux(Vec::max(left_u, zero)), phyFlux(Vec::min(right_u, zero)));
+	}
+};
+
+// Interface flux / r.t. first cell not processed
+template <typename PDE, int_t P>
+int_t interfaceSweep(const SweepData& data, int_t begin, int_t end)
+{
+	int_t icell = begin;
+	for (; icell + Vec::width <= end; icell += Vec::width)
+	{
+		// Local projection
+		Vec left_u = Vec::zero();
+		Vec right_u = Vec::zero();
+		for (int_t idegree = 0; idegree <= P; ++idegree)
+		{
+			left_u = Vec::add(left_u, Vec::mul(Vec::set1(data.faceRight[idegree]), Vec::load(data.DOF[idegree] + icell - 1)));
+			right_u = Vec::add(right_u, Vec::mul(Vec::set1(data.faceLeft[idegree]), Vec::load(data.DOF[idegree] + icell)));
+		}
+
+		// Calculate flux
+		Vec::store(data.flux + icell, VecFlux<PDE>::godunov(left_u, right_u));
+	}
+	return icell;
+}
+
+// Surface and volume integral / r.t. first cell not processed
+template <typename PDE, int_t P>
+int_t volumeSweep(const SweepData& data, int_t begin, int_t end)
+{
+	int_t icell = begin;
+	for (; icell + Vec::width <= end; icell += Vec::width)
+	{
+		// Physical flux at quadrature points
+		Vec phyFlux[QuadDegree];
+		if (P > 0)
+		{
+			for (int_t iquad = 0; iquad < QuadDegree; ++iquad)
+			{
+				Vec u = Vec::zero();
+				for (int_t idegree = 0; idegree <= P; ++idegree)
+					u = Vec::add(u, Vec::mul(Vec::set1(data.basisQuad[idegree*QuadDegree + iquad]), Vec::load(data.DOF[idegree] + icell)));
+				phyFlux[iquad] = VecFlux<PDE>::phyFlux(u);
+			}
+		}
+
+		Vec inv_sizeX = Vec::load(data.inv_sizeX + icell);
+		Vec flux_left = Vec::load(data.flux + icell);
+		Vec flux_right = Vec::load(data.flux + icell + 1);
+		for (int_t idegree = 0; idegree <= P; ++idegree)
+		{
+			Vec rhs = Vec::add(Vec::mul(Vec::set1(data.surfRight[idegree]), flux_right), Vec::mul(Vec::set1(data.surfLeft[idegree]), flux_left));
+			if (P > 0)
+			{
+				for (int_t iquad = 0; iquad < QuadDegree; ++iquad)
+					rhs = Vec::add(rhs, Vec::mul(Vec::set1(data.volume[idegree*QuadDegree + iquad]), phyFlux[iquad]));
+			}
+			Vec::store(data.RHS[idegree] + icell, Vec::mul(inv_sizeX, rhs));
+		}
+	}
+	return icell;
+}
\ No newline at end of file
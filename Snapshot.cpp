@@ -0,0 +1,145 @@
+#if defined(_WIN32)
+#include <cstdlib>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+#include <cstring>
+
+#include "Snapshot.h"
+#include "Decomposition.h"
+
+#define SNAPSHOT_MAGIC "RKDGSNP"
+#define SNAPSHOT_VERSION 2
+
+void Snapshot::write(const std::string& fileName, std::shared_ptr<Zone> zone, real_t time)
+{
+	const std::vector<std::shared_ptr<Cell> >& cell = zone->getGrid()->getCell();
+	const int_t num_cell = zone->getGrid()->getNumCell();
+	const int_t num_real = num_cell - 2 * GHOST;
+	const int_t num_mode = zone->getPolyOrder() + 1;
+
+	SnapshotHeader header;
+	std::memset(&header, 0, sizeof(header));
+	std::memcpy(header.magic, SNAPSHOT_MAGIC, sizeof(SNAPSHOT_MAGIC));
+	header.version = SNAPSHOT_VERSION;
+	header.polyOrder = zone->getPolyOrder();
+	header.numQuad = QuadDegree;
+	header.rank = Decomposition::getRank();
+	header.size = Decomposition::getSize();
+	header.numCell = num_real;
+	header.offset = zone->getGrid()->getOffset();
+	header.numGlobalCell = zone->getGrid()->getNumGlobalCell();
+	header.area = zone->getGrid()->getArea();
+	header.sizeX = zone->getGrid()->getMinSizeX();
+	header.time = time;
+
+	// One buffer for every array, written at once
+	std::vector<real_t> buffer(num_real*(2 + num_mode + QuadDegree));
+	real_t* center = buffer.data();
+	real_t* size = center + num_real;
+	real_t* DOF = size + num_real;
+	real_t* quadSolution = DOF + num_mode*num_real;
+	for (int_t icell = GHOST; icell < num_cell - GHOST; ++icell)
+	{
+		const int_t ireal = icell - GHOST;
+		const real_t posX = cell[icell]->getPosX();
+		const real_t sizeX = cell[icell]->getSizeX();
+		center[ireal] = posX;
+		size[ireal] = sizeX;
+		for (int_t imode = 0; imode < num_mode; ++imode)
+			DOF[imode*num_real + ireal] = zone->getModalDOF(imode, icell);
+		for (int_t iquad = 0; iquad < QuadDegree; ++iquad)
+			quadSolution[ireal*QuadDegree + iquad] = zone->getPolySolution(icell, posX + 0.5*sizeX*Gauss3_X(iquad));
+	}
+
+	std::ofstream file(fileName, std::ios::binary | std::ios::trunc);
+	if (!file.is_open()) ERROR("cannot open output file");
+	file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+	file.write(reinterpret_cast<const char*>(buffer.data()), buffer.size()*sizeof(real_t));
+	if (!file) ERROR("cannot write snapshot");
+}
+
+SnapshotReader::SnapshotReader(const std::string& fileName)
+{
+	_data = nullptr;
+	_length = 0;
+	_mapped = false;
+
+#if defined(_WIN32)
+	// Whole file in memory
+	std::ifstream file(fileName, std::ios::binary | std::ios::ate);
+	if (!file.is_open()) ERROR("cannot open snapshot file");
+	_length = size_t(file.tellg());
+	_data = std::malloc(std::max(_length, size_t(1)));
+	file.seekg(0);
+	file.read(static_cast<char*>(_data), _length);
+	if (!file) ERROR("cannot read snapshot file");
+#else
+	// Read-only mapping, pages are loaded on access
+	int fd = open(fileName.c_str(), O_RDONLY);
+	if (fd < 0) ERROR("cannot open snapshot file");
+	struct stat info;
+	if (fstat(fd, &info) != 0) ERROR("cannot read snapshot file");
+	_length = size_t(info.st_size);
+	if (_length < sizeof(SnapshotHeader)) ERROR("not a snapshot file");
+	_data = mmap(nullptr, _length, PROT_READ, MAP_PRIVATE, fd, 0);
+	close(fd);
+	if (_data == MAP_FAILED) ERROR("cannot map snapshot file");
+	_mapped = true;
+#endif
+
+	// Check header and size
+	_header = static_cast<const SnapshotHeader*>(_data);
+	if ((_length < sizeof(SnapshotHeader)) || (std::memcmp(_header->magic, SNAPSHOT_MAGIC, sizeof(SNAPSHOT_MAGIC)) != 0))
+		ERROR("not a snapshot file");
+	if ((_header->version != 1) && (_header->version != SNAPSHOT_VERSION)) ERROR("snapshot version");
+	if (_header->numQuad != QuadDegree) ERROR("snapshot quadrature");
+	const int_t num_geometry = (_header->version == 1) ? 0 : 2;
+	const size_t num_value = size_t(_header->numCell)*(num_geometry + _header->polyOrder + 1 + _header->numQuad);
+	if (_length != sizeof(SnapshotHeader) + num_value*sizeof(real_t)) ERROR("snapshot file size");
+
+	_posX = nullptr;
+	_sizeX = nullptr;
+	const real_t* data = reinterpret_cast<const real_t*>(_header + 1);
+	if (num_geometry > 0)
+	{
+		_posX = data;
+		_sizeX = data + _header->numCell;
+	}
+	_DOF = data + num_geometry*_header->numCell;
+	_quadSolution = _DOF + (_header->polyOrder + 1)*_header->numCell;
+}
+
+SnapshotReader::~SnapshotReader()
+{
+#if defined(_WIN32)
+	std::free(_data);
+#else
+	if (_mapped) munmap(_data, _length);
+#endif
+}
+
+void SnapshotReader::toTecplot(const std::string& fileName) const
+{
+	const int_t num_element = int_t(_header->numCell*_header->numQuad);
+
+	std::ofstream file;
+	file.open(fileName, std::ios::trunc);
+	if (!file.is_open()) ERROR("cannot open output file");
+
+	// Same text as Post::write
+	file << "variables = " << "X" << ", " << "Velocity" << "\n";
+	file << "zone t = \"RKDG 1D\", i=" << num_element << ", f=point\n";
+	for (int_t icell = 0; icell < _header->numCell; ++icell)
+	{
+		for (int_t iquad = 0; iquad < _header->numQuad; ++iquad)
+		{
+			real_t X = getPosX(icell) + 0.5*getSizeX(icell)*Gauss3_X(iquad);
+			file << std::to_string(X) << "\t" << std::to_string(_quadSolution[icell*_header->numQuad + iquad]) << "\n";
+		}
+	}
+	file.close();
+}
\ No newline at end of file
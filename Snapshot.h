@@ -0,0 +1,76 @@
+#pragma once
+#include <cstdint>
+#include "DataType.h"
+#include "Zone.h"
+
+// Binary snapshot of DG solution
+// Layout : SnapshotHeader, cell center[cell], cell size[cell], modal DOF[mode][cell], polynomial solution at quadrature points[cell][QuadDegree]
+// Only real cells are stored, every value is real_t in native byte order.
+// Version 1 files have no center and size arrays, cells follow from the uniform grid of the header.
+struct SnapshotHeader
+{
+	char magic[8]; /// "RKDGSNP"
+	int32_t version;
+	int32_t polyOrder;
+	int32_t numQuad; /// quadrature points per cell
+	int32_t rank;
+	int32_t size; /// number of ranks
+	int32_t reserved;
+	int64_t numCell; /// real cells of this file
+	int64_t offset; /// global index of first cell
+	int64_t numGlobalCell;
+	real_t area;
+	real_t sizeX; /// smallest cell size
+	real_t time;
+};
+
+class Snapshot
+{
+public:
+	// Write snapshot / p.m. file name, Zone(object), time
+	static void write(const std::string&, std::shared_ptr<Zone>, real_t);
+};
+
+// Read-only view of a snapshot file, memory-mapped where available
+class SnapshotReader
+{
+public:
+	// Constructor / p.m. file name
+	SnapshotReader(const std::string&);
+
+	// Destructor
+	~SnapshotReader();
+
+public:
+	// Functions
+	inline const SnapshotHeader& getHeader() const { return *_header; }
+
+	// Center of cell / p.m. cell index of file
+	inline real_t getPosX(int_t icell) const { return (_posX != nullptr) ? _posX[icell] : -0.5*_header->area + _header->sizeX*(0.5 + (_header->offset + icell)); }
+
+	// Size of cell / p.m. cell index of file
+	inline real_t getSizeX(int_t icell) const { return (_sizeX != nullptr) ? _sizeX[icell] : _header->sizeX; }
+
+	// DOF of one mode / p.m. mode
+	inline const real_t* getDOF(int_t imode) const { return _DOF + imode*_header->numCell; }
+
+	inline const real_t* getQuadSolution() const { return _quadSolution; }
+
+	// Write Tecplot file of quadrature-point solution, same as Post::DGsolution / p.m. file name
+	void toTecplot(const std::string&) const;
+
+protected:
+	// Variables
+	const SnapshotHeader* _header;
+	const real_t* _posX; /// nullptr : uniform grid of version 1
+	const real_t* _sizeX;
+	const real_t* _DOF;
+	const real_t* _quadSolution;
+	void* _data; /// mapped or loaded file
+	size_t _length;
+	bool _mapped;
+
+private:
+	SnapshotReader(const SnapshotReader&);
+	SnapshotReader& operator=(const SnapshotReader&);
+};
\ No newline at end of file
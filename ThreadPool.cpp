@@ -0,0 +1,307 @@
+// Standard thread headers before DataType.h (epsilon macro)
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <atomic>
+#include <cstdlib>
+
+#ifdef RKDG_USE_OPENMP
+#ifndef _OPENMP
+#error "RKDG_USE_OPENMP needs OpenMP enabled (-fopenmp, /openmp)"
+#endif
+#include <omp.h>
+#endif
+
+#if defined(_MSC_VER) && (defined(_M_X64) || defined(_M_IX86))
+#include <intrin.h>
+#endif
+
+#include "ThreadPool.h"
+
+// Number of polls before a waiting thread yields, about a microsecond of pause instructions
+#define THREAD_SPIN 1024
+
+// Number of yields before a waiting worker sleeps
+#define THREAD_YIELD 64
+
+// True while the calling thread runs a chunk
+static thread_local bool inside_chunk = false;
+
+// Pool index of the calling thread, for per-thread work storage
+static thread_local int_t thread_index = 0;
+
+// Pause in spin loops
+static inline void relax()
+{
+#if defined(_MSC_VER) && (defined(_M_X64) || defined(_M_IX86))
+	_mm_pause();
+#elif defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+	__builtin_ia32_pause();
+#endif
+}
+
+struct ThreadPool::State
+{
+	int_t num_thread;
+
+#ifndef RKDG_USE_OPENMP
+	// Workers 1 ~ num_thread-1, the calling thread runs chunk 0
+	std::vector<std::thread> worker;
+	std::mutex mutex;
+	std::condition_variable wake;
+	std::atomic<int_t> generation; /// incremented for every phase
+	std::atomic<int_t> pending; /// workers not finished with current phase
+	std::atomic<int_t> sleeping; /// workers blocked on wake
+	std::atomic<bool> stop;
+	int_t spin; /// polls before yielding, none when threads outnumber cores
+
+	// Current phase, written before generation is incremented
+	TaskFtn task;
+	void* context;
+	int_t begin;
+	int_t end;
+	int_t num_chunk;
+
+	State() : num_thread(1), generation(0), pending(0), sleeping(0), stop(false), spin(THREAD_SPIN),
+		task(nullptr), context(nullptr), begin(0), end(0), num_chunk(1) {}
+
+	// Worker loop / p.m. thread index, generation at thread creation
+	void loop(int_t ithread, int_t seen)
+	{
+		inside_chunk = true;
+		thread_index = ithread;
+		while (true)
+		{
+			// Wait for next phase : spin first, yield the core, then sleep
+			int_t poll = 0;
+			while ((generation.load(std::memory_order_acquire) == seen) && !stop.load(std::memory_order_acquire))
+			{
+				if (++poll < spin) { relax(); continue; }
+				if (poll < spin + THREAD_YIELD) { std::this_thread::yield(); continue; }
+
+				std::unique_lock<std::mutex> lock(mutex);
+				sleeping.fetch_add(1);
+				wake.wait(lock, [&] { return (generation.load(std::memory_order_acquire) != seen) || stop.load(std::memory_order_acquire); });
+				sleeping.fetch_sub(1);
+				break;
+			}
+			if (stop.load(std::memory_order_acquire)) return;
+			seen = generation.load(std::memory_order_acquire);
+
+			// Every worker acknowledges the phase, so the phase variables are not rewritten while read
+			if (ithread < num_chunk)
+			{
+				int_t chunk_begin, chunk_end;
+				ThreadPool::chunk(ithread, num_chunk, begin, end, chunk_begin, chunk_end);
+				task(context, ithread, chunk_begin, chunk_end);
+			}
+			pending.fetch_sub(1, std::memory_order_acq_rel);
+		}
+	}
+
+	// Start workers / p.m. number of threads
+	void start(int_t num)
+	{
+		// A worker scheduled late must not skip a phase published before it runs
+		num_thread = num;
+		stop.store(false);
+
+		// Spinning threads of an oversubscribed pool hold the cores of the threads they wait for
+		const int_t num_core = int_t(std::thread::hardware_concurrency());
+		spin = ((num_core > 0) && (num_thread > num_core)) ? 0 : THREAD_SPIN;
+		for (int_t ithread = 1; ithread < num_thread; ++ithread)
+			worker.emplace_back(&State::loop, this, ithread, generation.load(std::memory_order_acquire));
+	}
+
+	// Join workers
+	void join()
+	{
+		{
+			std::lock_guard<std::mutex> lock(mutex);
+			stop.store(true, std::memory_order_release);
+		}
+		wake.notify_all();
+		for (size_t ithread = 0; ithread < worker.size(); ++ithread)
+			worker[ithread].join();
+		worker.clear();
+		num_thread = 1;
+	}
+#else
+	State() : num_thread(1) {}
+#endif
+};
+
+ThreadPool::ThreadPool()
+{
+	_state = new State;
+}
+
+ThreadPool::~ThreadPool()
+{
+#ifndef RKDG_USE_OPENMP
+	_state->join();
+#endif
+	delete _state;
+}
+
+int_t ThreadPool::select(int_t option)
+{
+	int_t num_thread = option;
+
+	// Environment variable overrides input file
+	const char* env = std::getenv("RKDG_NUM_THREADS");
+	if ((env != nullptr) && (*env != '\0')) num_thread = std::atoi(env);
+
+	if (num_thread < 0) ERROR("number of threads");
+	if (num_thread == 0)
+	{
+#ifdef RKDG_USE_OPENMP
+		num_thread = omp_get_max_threads();
+#else
+		num_thread = std::max(int_t(std::thread::hardware_concurrency()), 1);
+#endif
+	}
+
+	return std::min(num_thread, THREAD_MAX);
+}
+
+void ThreadPool::setNumThread(int_t num_thread)
+{
+	num_thread = std::max(std::min(num_thread, THREAD_MAX), 1);
+	State& state = *_pool._state;
+	if (num_thread == state.num_thread) return;
+
+#ifdef RKDG_USE_OPENMP
+	state.num_thread = num_thread;
+#else
+	state.join();
+	state.start(num_thread);
+#endif
+}
+
+int_t ThreadPool::getNumThread()
+{
+	return _pool._state->num_thread;
+}
+
+int_t ThreadPool::getThreadIndex()
+{
+	return thread_index;
+}
+
+void ThreadPool::chunk(int_t ithread, int_t num_chunk, int_t begin, int_t end, int_t& chunk_begin, int_t& chunk_end)
+{
+	// Even split, inner boundaries aligned so that chunks do not share cache lines
+	auto boundary = [&](int_t index)
+	{
+		if (index <= 0) return begin;
+		if (index >= num_chunk) return end;
+		int_t cell = begin + int_t((long long)(end - begin)*index / num_chunk);
+		cell -= cell % THREAD_ALIGN;
+		return std::min(std::max(cell, begin), end);
+	};
+
+	chunk_begin = boundary(ithread);
+	chunk_end = boundary(ithread + 1);
+}
+
+void ThreadPool::run(TaskFtn task, void* context, int_t begin, int_t end)
+{
+	State& state = *_pool._state;
+	int_t num_chunk = std::min(state.num_thread, std::max((end - begin) / THREAD_GRAIN, 1));
+
+	// Serial : small range, one thread or nested call
+	if ((num_chunk <= 1) || inside_chunk)
+	{
+		task(context, 0, begin, end);
+		return;
+	}
+
+	launch(task, context, begin, end, num_chunk);
+}
+
+// Shared task counter of runQueue
+struct TaskQueue
+{
+	void(*task)(void*, int_t, int_t, int_t);
+	void* context;
+	int_t num_task;
+	std::atomic<int_t> next;
+};
+
+static void queueTask(void* context, int_t ithread, int_t, int_t)
+{
+	TaskQueue& queue = *static_cast<TaskQueue*>(context);
+	for (int_t itask = queue.next.fetch_add(1); itask < queue.num_task; itask = queue.next.fetch_add(1))
+		queue.task(queue.context, ithread, itask, itask + 1);
+}
+
+void ThreadPool::runQueue(TaskFtn task, void* context, int_t num_task)
+{
+	State& state = *_pool._state;
+	int_t num_chunk = std::min(state.num_thread, num_task);
+
+	// Serial : one task, one thread or nested call
+	if ((num_chunk <= 1) || inside_chunk)
+	{
+		for (int_t itask = 0; itask < num_task; ++itask)
+			task(context, 0, itask, itask + 1);
+		return;
+	}
+
+	// One chunk per thread, every chunk pulls tasks until the counter runs out
+	TaskQueue queue;
+	queue.task = task;
+	queue.context = context;
+	queue.num_task = num_task;
+	queue.next.store(0);
+	launch(&queueTask, &queue, 0, num_chunk, num_chunk);
+}
+
+void ThreadPool::launch(TaskFtn task, void* context, int_t begin, int_t end, int_t num_chunk)
+{
+#ifdef RKDG_USE_OPENMP
+#pragma omp parallel num_threads(num_chunk)
+	{
+		int_t ithread = omp_get_thread_num();
+		int_t chunk_begin, chunk_end;
+		chunk(ithread, omp_get_num_threads(), begin, end, chunk_begin, chunk_end);
+		inside_chunk = true;
+		thread_index = ithread;
+		task(context, ithread, chunk_begin, chunk_end);
+		inside_chunk = false;
+		thread_index = 0;
+	}
+#else
+	// Publish phase
+	State& state = *_pool._state;
+	state.task = task;
+	state.context = context;
+	state.begin = begin;
+	state.end = end;
+	state.num_chunk = num_chunk;
+	state.pending.store(state.num_thread - 1, std::memory_order_relaxed);
+	state.generation.fetch_add(1, std::memory_order_release);
+	{
+		std::lock_guard<std::mutex> lock(state.mutex);
+	}
+	if (state.sleeping.load() > 0) state.wake.notify_all();
+
+	// Chunk 0 on the calling thread
+	int_t chunk_begin, chunk_end;
+	chunk(0, num_chunk, begin, end, chunk_begin, chunk_end);
+	inside_chunk = true;
+	task(context, 0, chunk_begin, chunk_end);
+	inside_chunk = false;
+
+	// Barrier
+	int_t poll = 0;
+	while (state.pending.load(std::memory_order_acquire) != 0)
+	{
+		if (++poll < state.spin) relax();
+		else std::this_thread::yield();
+	}
+#endif
+}
+
+ThreadPool ThreadPool::_pool;
\ No newline at end of file
@@ -0,0 +1,115 @@
+#pragma once
+#include "DataType.h"
+
+// Maximum number of threads
+#define THREAD_MAX 256
+
+// Minimum number of cells in one chunk
+#define THREAD_GRAIN 1024
+
+// Chunk boundaries are aligned to this number of cells (cache line of real_t)
+#define THREAD_ALIGN 8
+
+// Persistent thread pool partitioning a cell range into chunks
+// Threads are created once and wait between phases, every parallel call ends with a barrier.
+// Backend : std::thread (default) or OpenMP (compile with RKDG_USE_OPENMP and OpenMP enabled)
+// A parallel call from inside a chunk runs serially on the calling thread.
+class ThreadPool
+{
+protected:
+	ThreadPool();
+	~ThreadPool();
+
+public:
+	// Number of threads from input option and environment variable RKDG_NUM_THREADS
+	// p.m. number of threads in input file(0 : hardware concurrency) / r.t. number of threads
+	static int_t select(int_t);
+
+	// Start threads / p.m. number of threads
+	static void setNumThread(int_t);
+
+	static int_t getNumThread();
+
+	// Pool index of the calling thread, 0 outside parallel runs / r.t. thread index(0 ~ THREAD_MAX-1)
+	static int_t getThreadIndex();
+
+	// Chunk of a thread / p.m. thread index, number of chunks, begin cell, end cell(exclusive), chunk begin(output), chunk end(output)
+	static void chunk(int_t, int_t, int_t, int_t, int_t&, int_t&);
+
+	// Run body(chunk begin, chunk end) on every chunk of [begin, end)
+	template <typename Body>
+	static void parallelFor(int_t begin, int_t end, Body& body)
+	{
+		run(&invokeFor<Body>, &body, begin, end);
+	}
+
+	// Maximum of body(chunk begin, chunk end) over every chunk of [begin, end) / p.m. begin, end, initial value, body
+	template <typename Body>
+	static real_t parallelMax(int_t begin, int_t end, real_t init, Body& body)
+	{
+		real_t partial[THREAD_MAX];
+		std::fill(partial, partial + THREAD_MAX, init);
+		MaxTask<Body> task = { &body, partial };
+		run(&invokeMax<Body>, &task, begin, end);
+
+		real_t result = init;
+		for (int_t ithread = 0; ithread < THREAD_MAX; ++ithread)
+			result = std::max(result, partial[ithread]);
+		return result;
+	}
+
+	// Run body(task index) for every task of [0, number of tasks), tasks are handed out one at a time to free threads
+	// p.m. number of tasks, body
+	template <typename Body>
+	static void parallelTask(int_t num_task, Body& body)
+	{
+		runQueue(&invokeTask<Body>, &body, num_task);
+	}
+
+protected:
+	// Chunk task / p.m. context, thread index, chunk begin, chunk end
+	typedef void(*TaskFtn)(void*, int_t, int_t, int_t);
+
+	template <typename Body>
+	struct MaxTask
+	{
+		Body* body;
+		real_t* partial;
+	};
+
+	template <typename Body>
+	static void invokeFor(void* context, int_t, int_t begin, int_t end)
+	{
+		(*static_cast<Body*>(context))(begin, end);
+	}
+
+	template <typename Body>
+	static void invokeMax(void* context, int_t ithread, int_t begin, int_t end)
+	{
+		MaxTask<Body>* task = static_cast<MaxTask<Body>*>(context);
+		task->partial[ithread] = (*task->body)(begin, end);
+	}
+
+	template <typename Body>
+	static void invokeTask(void* context, int_t, int_t itask, int_t)
+	{
+		(*static_cast<Body*>(context))(itask);
+	}
+
+	// Run task on every chunk and wait for all threads / p.m. task, context, begin, end
+	static void run(TaskFtn, void*, int_t, int_t);
+
+	// Run task on every index from a shared counter and wait for all threads / p.m. task, context, number of tasks
+	static void runQueue(TaskFtn, void*, int_t);
+
+	// Start phase of chunks and wait for all threads / p.m. task, context, begin, end, number of chunks
+	static void launch(TaskFtn, void*, int_t, int_t, int_t);
+
+	// Backend state(threads and synchronization)
+	struct State;
+	State* _state;
+
+private:
+	// ThreadPool variable
+	static ThreadPool _pool;
+};
\ No newline at end of file
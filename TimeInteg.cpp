@@ -1,4 +1,6 @@
 #include "TimeInteg.h"
+#include "Decomposition.h"
+#include "Timer.h"
 
 TimeInteg::TimeInteg(Type PDEtype, Type fluxType, Type limiterType, real_t CFL, real_t targetTime, std::shared_ptr<Zone> zone, std::shared_ptr<Boundary> bdry)
 {
@@ -9,18 +11,16 @@ TimeInteg::TimeInteg(Type PDEtype, Type fluxType, Type limiterType, real_t CFL,
 
 	// Initializing objects
 	_zone = zone; _bdry = bdry;
-	_basis = std::make_shared<DGbasis>(zone->getPolyOrder(), zone->getGrid());
+	_limiter = std::make_shared<Limiter>(limiterType, zone);
 
 	// Initializing temporary variables
-	_godFlux = std::make_shared<ConvFluxGodunov>(PDEtype, zone);
 	_temp_solution.resize(zone->getGrid()->getNumCell());
-	_prev_DOF.resize(zone->getPolyOrder() + 1);
-	_temp_RHS.resize(zone->getPolyOrder() + 1);
-	for (int_t iorder = 0; iorder <= zone->getPolyOrder(); ++iorder)
-	{
-		_prev_DOF[iorder].resize(zone->getGrid()->getNumCell());
-		_temp_RHS[iorder].resize(zone->getGrid()->getNumCell());
-	}
+	_prev_DOF = DOFArray(zone->getPolyOrder() + 1, zone->getGrid()->getNumCell(), zone->getLayout());
+	_temp_RHS = DOFArray(zone->getPolyOrder() + 1, zone->getGrid()->getNumCell(), zone->getLayout());
+
+	// RHS kernel specialized to PDE, flux scheme, polynomial order and DOF representation
+	if (zone->isNodal()) _rhsKernel = RHSKernel::createNodal(zone->getPolyOrder(), PDEtype, fluxType, zone->getGrid()->getNumCell());
+	else _rhsKernel = RHSKernel::create(zone->getPolyOrder(), PDEtype, fluxType, zone->getGrid()->getNumCell());
 }
 
 TimeInteg::~TimeInteg()
@@ -28,94 +28,51 @@ TimeInteg::~TimeInteg()
 
 }
 
-std::vector<std::vector<real_t> > TimeInteg::computeRHS(std::shared_ptr<Zone> zone) const
+void TimeInteg::computeRHS(std::shared_ptr<Zone> zone, DOFArray& DOF)
 {
-	real_t sizeX = zone->getGrid()->getSizeX();
-	real_t inv_sizeX = 1.0/(zone->getGrid()->getSizeX());
-	int_t num_cell = zone->getGrid()->getNumCell();
-	int_t polyOrder = zone->getPolyOrder();
-
-	// Temporary degree of freedom
-	std::vector<std::vector<real_t> > DOF;
-	std::vector<std::vector<real_t> > temp_DOF = zone->getDOF();
-	DOF.resize(polyOrder + 1);
-	for (int_t iorder = 0; iorder <= polyOrder; ++iorder)
-		DOF[iorder].resize(num_cell);
-	
-	// DG flux
-	std::vector<real_t> flux(num_cell, 0.0);
-	real_t for_projec, back_projec, left_u, right_u;
-	for (int_t icell = GHOST; icell <= num_cell - GHOST; ++icell)
-	{
-		// Calculate flux inputs
-		// Local projection
-		for_projec = back_projec = 0.0;
-		if (polyOrder > 0)
-		{
-			for_projec = PROJEC_COEFF2*temp_DOF[1][icell - 1];
-			back_projec = PROJEC_COEFF2*temp_DOF[1][icell];
-		}
-		if (polyOrder > 1)
-		{
-			for_projec += PROJEC_COEFF3*temp_DOF[2][icell - 1];
-			back_projec += -PROJEC_COEFF3*temp_DOF[2][icell];
-		}
-
-		// Cell quantity
-		left_u = PROJEC_COEFF1 * temp_DOF[0][icell - 1] + for_projec;
-		right_u = PROJEC_COEFF1 * temp_DOF[0][icell] - back_projec;
-
-		// Calculate flux
-		flux[icell] = _godFlux->computeFlux(left_u, right_u);
-	}
-
-	// Calculate DOF
-	for (int_t icell = GHOST; icell < num_cell - GHOST; ++icell)
-	{
-		// degree 0
-		DOF[0][icell] = -inv_sizeX*(flux[icell + 1] - flux[icell]);
-
-		// degree 1
-		if (polyOrder > 0)
-		{
-			DOF[1][icell] = -0.5*inv_sizeX*(flux[icell + 1] + flux[icell]);
-			real_t temp_x = zone->getGrid()->getCell()[icell]->getPosX();
-			for (int_t idegree = 0; idegree < QuadDegree; ++idegree)
-				DOF[1][icell] += 0.5*inv_sizeX*Gauss3_W(idegree)*PHY_FLUX(_PDEtype, zone->getPolySolution(icell, temp_x + 0.5*sizeX*Gauss3_X(idegree)));
-		}
+	TIMER_SCOPE(Phase::RHS);
+	_rhsKernel->compute(zone, DOF);
+}
 
-		// degree 2
-		if (polyOrder > 1)
-		{
-			DOF[2][icell] = -CONST16*inv_sizeX*(flux[icell + 1] - flux[icell]);
-			real_t temp_x = zone->getGrid()->getCell()[icell]->getPosX();
-			for (int_t idegree = 0; idegree < QuadDegree; ++idegree)
-				DOF[2][icell] += pow(inv_sizeX, 2.0)*Gauss3_W(idegree)*PHY_FLUX(_PDEtype, zone->getPolySolution(icell, temp_x + 0.5*sizeX*Gauss3_X(idegree)))
-				*_basis->basis(1, icell, temp_x + 0.5*sizeX*Gauss3_X(idegree));
-		}
-	}
-	
-	return DOF;
+void TimeInteg::computeRHS(std::shared_ptr<Zone> zone, DOFArray& DOF, int_t begin, int_t end)
+{
+	TIMER_SCOPE(Phase::RHS);
+	_rhsKernel->compute(zone, DOF, begin, end);
 }
 
 void TimeInteg::computeTimeStep(std::shared_ptr<Zone> zone)
 {
+	TIMER_SCOPE(Phase::TimeStep);
+
 	if (_PDEtype == "advection")
-		_timeStep = _CFL*zone->getGrid()->getSizeX() / abs(GET_SPEED) / double(2*zone->getPolyOrder() + 1);
+		_timeStep = _CFL*zone->getGrid()->getMinSizeX() / std::abs(GET_SPEED) / double(2*zone->getPolyOrder() + 1);
 
 	else if (_PDEtype == "burgers")
 	{
-		real_t temp_sol1;
-		real_t temp_sol2;
-		std::vector<real_t> shockSpeed(zone->getGrid()->getNumCell() - 1, 0.0);
-		for (int_t icell = 0; icell < shockSpeed.size(); ++icell)
+		// Speed of each face scaled to the smallest cell, min(dX)/max(speed*min(dX)/dX) is the limit of every face
+		const std::vector<real_t>& solution = zone->getDescSolution();
+		const std::vector<real_t>& sizeX = zone->getGrid()->getSizeX();
+		const real_t minSizeX = zone->getGrid()->getMinSizeX();
+		auto chunkSpeed = [&](int_t begin, int_t end)
 		{
-			temp_sol1 = zone->getDescSolution()[icell];
-			temp_sol2 = zone->getDescSolution()[icell + 1];
-			if (temp_sol1 >= temp_sol2) shockSpeed[icell] = 0.5*abs(temp_sol1 + temp_sol2);
-			else shockSpeed[icell] = std::max(abs(temp_sol1), abs(temp_sol2));
-		}
-		_timeStep = _CFL*zone->getGrid()->getSizeX() / *std::max_element(shockSpeed.begin(), shockSpeed.end()) / double(2*zone->getPolyOrder() + 1);
+			real_t temp_sol1;
+			real_t temp_sol2;
+			real_t shockSpeed;
+			real_t maxSpeed = 0.0;
+			for (int_t icell = begin; icell < end; ++icell)
+			{
+				temp_sol1 = solution[icell];
+				temp_sol2 = solution[icell + 1];
+				if (temp_sol1 >= temp_sol2) shockSpeed = 0.5*std::abs(temp_sol1 + temp_sol2);
+				else shockSpeed = std::max(std::abs(temp_sol1), std::abs(temp_sol2));
+				shockSpeed *= minSizeX / std::min(sizeX[icell], sizeX[icell + 1]);
+				maxSpeed = std::max(maxSpeed, shockSpeed);
+			}
+			return maxSpeed;
+		};
+		real_t maxSpeed = ThreadPool::parallelMax(0, zone->getGrid()->getNumCell() - 1, 0.0, chunkSpeed);
+		maxSpeed = Decomposition::maxAll(maxSpeed);
+		_timeStep = _CFL*minSizeX / maxSpeed / double(2*zone->getPolyOrder() + 1);
 	}
 }
 
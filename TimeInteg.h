@@ -4,6 +4,7 @@
 #include "ConvFluxGodunov.h"
 #include "Boundary.h"
 #include "Limiter.h"
+#include "RHSKernel.h"
 
 class TimeInteg
 {
@@ -26,18 +27,21 @@ public:
 
 	inline real_t getTargetTime() const { return _targetTime; }
 
+	// Resume from checkpoint / p.m. current time, time step of last step
+	inline void restart(real_t currentTime, real_t timeStep) { _currentTime = currentTime; _timeStep = timeStep; }
+
 	// Compute time integration / p.m. Zone(object) / r.t. go/stop
 	virtual bool march(std::shared_ptr<Zone>) = 0;
 
 protected:
 	// Variables
 	std::vector<real_t> _temp_solution;
-	std::vector<std::vector<real_t> > _prev_DOF;
-	std::vector<std::vector<real_t> > _temp_RHS;
+	DOFArray _prev_DOF;
+	DOFArray _temp_RHS;
 	std::shared_ptr<Zone> _zone;
-	std::shared_ptr<ConvFluxGodunov> _godFlux;
 	std::shared_ptr<Boundary> _bdry;
-	std::shared_ptr<DGbasis> _basis;
+	std::shared_ptr<Limiter> _limiter;
+	std::shared_ptr<RHSKernel> _rhsKernel;
 	Type _PDEtype;
 	Type _fluxType;
 	Type _limiterType;
@@ -48,8 +52,11 @@ protected:
 
 protected:
 	// Functions
-	// Compute right hand side / p.m. Zone to compute
-	std::vector<std::vector<real_t> > computeRHS(std::shared_ptr<Zone>) const;
+	// Compute right hand side / p.m. Zone to compute, RHS(output)
+	void computeRHS(std::shared_ptr<Zone>, DOFArray&);
+
+	// Compute right hand side of cell range / p.m. Zone to compute, RHS(output), begin cell, end cell(exclusive)
+	void computeRHS(std::shared_ptr<Zone>, DOFArray&, int_t, int_t);
 
 	// Compute time step / p.m. Zone(object)
 	void computeTimeStep(std::shared_ptr<Zone>);
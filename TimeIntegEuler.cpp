@@ -1,11 +1,10 @@
 #include "TimeIntegEuler.h"
+#include "Timer.h"
 
 TimeIntegEuler::TimeIntegEuler(Type PDEtype, Type fluxType, Type limiterType, real_t CFL, real_t targetTime, std::shared_ptr<Zone> zone, std::shared_ptr<Boundary> bdry)
 	:TimeInteg(PDEtype, fluxType, limiterType, CFL, targetTime, zone, bdry)
 {
-	_temp_DOF.resize(zone->getPolyOrder() + 1);
-	for (int_t iorder = 0; iorder <= zone->getPolyOrder(); ++iorder)
-		_temp_DOF[iorder].resize(zone->getGrid()->getNumCell());
+	_temp_DOF = DOFArray(zone->getPolyOrder() + 1, zone->getGrid()->getNumCell(), zone->getLayout());
 }
 
 TimeIntegEuler::~TimeIntegEuler()
@@ -20,7 +19,7 @@ bool TimeIntegEuler::march(std::shared_ptr<Zone> zone)
 
 	// Marching starts
 	bool procedure = true;
-	if (abs(_currentTime) < epsilon) MESSAGE("Marching starts.....");
+	if (std::abs(_currentTime) < epsilon) MESSAGE("Marching starts.....");
 
 	// Calculate time step
 	if ((_currentTime + _timeStep) > _targetTime)
@@ -31,25 +30,37 @@ bool TimeIntegEuler::march(std::shared_ptr<Zone> zone)
 	else computeTimeStep(zone);
 
 	// Apply hMLP limiter
-	std::shared_ptr<Limiter> limiter = std::make_shared<Limiter>(_limiterType, zone);
-	limiter->hMLP_Limiter(zone);
+	_limiter->hMLP_Limiter(zone);
 
 	// Save previous degree of freedom
-	_prev_DOF = zone->getDOF();
+	const int_t num_cell = zone->getGrid()->getNumCell();
+	auto savePrev = [&](int_t begin, int_t end) { _prev_DOF.assign(zone->getDOF(), begin, end); };
+	{
+		TIMER_SCOPE(Phase::Update);
+		ThreadPool::parallelFor(0, num_cell, savePrev);
+	}
 
 	// Calculate RHS
-	_temp_RHS = computeRHS(zone);
+	computeRHS(zone, _temp_RHS);
 
 	// Calculate DOF
-	for (int_t idegree = 0; idegree <= zone->getPolyOrder(); ++idegree)
+	auto update = [&](int_t begin, int_t end)
 	{
-		for (int_t icell = 0; icell < zone->getGrid()->getNumCell(); ++icell)
-			_temp_DOF[idegree][icell] = _prev_DOF[idegree][icell] + _timeStep*_temp_RHS[idegree][icell];
+		for (int_t idegree = 0; idegree <= zone->getPolyOrder(); ++idegree)
+		{
+			for (int_t icell = begin; icell < end; ++icell)
+				_temp_DOF(idegree, icell) = _prev_DOF(idegree, icell) + _timeStep*_temp_RHS(idegree, icell);
+		}
+		zone->getDOF().assign(_temp_DOF, begin, end);
+	};
+	{
+		TIMER_SCOPE(Phase::Update);
+		ThreadPool::parallelFor(0, num_cell, update);
 	}
-	zone->setDOF(_temp_DOF);
 
-	// Apply hMLP limiter
-	limiter->hMLP_Limiter(zone);
+	// Apply hMLP limiter, order of cells for next time step
+	_limiter->hMLP_Limiter(zone);
+	_limiter->adaptDegree(zone);
 
 	// Calculate solution
 	zone->calSolution();
@@ -18,5 +18,5 @@ public:
 
 protected:
 	// Variables
-	std::vector<std::vector<real_t> > _temp_DOF;
+	DOFArray _temp_DOF;
 };
\ No newline at end of file
@@ -0,0 +1,314 @@
+#include <limits>
+
+#include "TimeIntegLTS.h"
+#include "Timer.h"
+#include "Decomposition.h"
+
+TimeIntegLTS::TimeIntegLTS(Type PDEtype, Type fluxType, Type limiterType, real_t CFL, real_t targetTime, std::shared_ptr<Zone> zone, std::shared_ptr<Boundary> bdry, int_t numLevel)
+	:TimeInteg(PDEtype, fluxType, limiterType, CFL, targetTime, zone, bdry)
+{
+	if (Decomposition::getSize() > 1) ERROR("local time stepping runs on a single rank");
+	if ((numLevel < 1) || (numLevel > 16)) ERROR("local time stepping levels");
+	if (zone->isNodal()) ERROR("local time stepping supports modal basis only");
+
+	_numLevel = numLevel;
+	_num_cell = zone->getGrid()->getNumCell();
+	_periodic = (bdry->getType() == "periodic");
+	_temp_DOF.resize(2);
+	for (int_t istage = 0; istage < 2; ++istage)
+		_temp_DOF[istage] = DOFArray(zone->getPolyOrder() + 1, _num_cell, zone->getLayout());
+	_temp_zone = std::make_shared<Zone>(*zone);
+	_localStep.assign(_num_cell, 0.0);
+	_level.assign(_num_cell, 0);
+	_run.resize(numLevel);
+	_levelTime.assign(numLevel, 0.0);
+	_coarseFlux.assign(_num_cell + 1, 0.0);
+	_fineFlux.assign(_num_cell + 1, 0.0);
+	_num_update = 0.0;
+	_num_global = 0.0;
+}
+
+TimeIntegLTS::~TimeIntegLTS()
+{
+
+}
+
+bool TimeIntegLTS::march(std::shared_ptr<Zone> zone)
+{
+	// Apply boundary condition, ghost cells of solution Zone stay at start of step as in TimeIntegRK
+	_bdry->apply(zone);
+
+	// Marching starts
+	bool procedure = true;
+	if (std::abs(_currentTime) < epsilon) MESSAGE("Marching starts.....");
+
+	// Calculate time step and levels
+	if ((_currentTime + _timeStep) > _targetTime)
+	{
+		_timeStep = _targetTime - _currentTime;
+		procedure = false;
+		computeLevel(zone, false);
+	}
+	else computeLevel(zone, true);
+	if (zone->isAdaptiveOrder()) _temp_zone->setDegree(zone->getDegree());
+
+	// Levels from coarse to fine
+	marchLevel(zone, 0, _currentTime, _timeStep);
+
+	// Apply hMLP limiter, order of cells for next time step
+	_limiter->hMLP_Limiter(zone);
+	_limiter->adaptDegree(zone);
+
+	// Calculate solution
+	zone->calSolution();
+
+	// Update current time
+	_currentTime += _timeStep;
+
+	// Print finish condition
+	if (!procedure)
+	{
+		print();
+		MESSAGE("Cell stages of local time steps = " + std::to_string(int64_t(_num_update)) + ", of global time step = " + std::to_string(int64_t(_num_global)));
+	}
+
+	return procedure;
+}
+
+void TimeIntegLTS::computeLevel(std::shared_ptr<Zone> zone, bool setStep)
+{
+	TIMER_SCOPE(Phase::TimeStep);
+
+	// Stable time step of every cell, Burgers takes the faster face
+	const std::vector<real_t>& solution = zone->getDescSolution();
+	const std::vector<real_t>& sizeX = zone->getGrid()->getSizeX();
+	const int_t polyOrder = zone->getPolyOrder();
+	auto faceSpeed = [&](int_t icell)
+	{
+		real_t temp_sol1 = solution[icell - 1];
+		real_t temp_sol2 = solution[icell];
+		if (temp_sol1 >= temp_sol2) return 0.5*std::abs(temp_sol1 + temp_sol2);
+		return std::max(std::abs(temp_sol1), std::abs(temp_sol2));
+	};
+	auto localStep = [&](int_t begin, int_t end)
+	{
+		for (int_t icell = begin; icell < end; ++icell)
+		{
+			real_t speed = 0.0;
+			if (_PDEtype == "advection") speed = std::abs(GET_SPEED);
+			else if (_PDEtype == "burgers") speed = std::max(faceSpeed(icell), faceSpeed(icell + 1));
+			if (speed > 0.0) _localStep[icell] = _CFL*sizeX[icell] / speed / double(2 * polyOrder + 1);
+			else _localStep[icell] = std::numeric_limits<real_t>::max();
+		}
+	};
+	ThreadPool::parallelFor(GHOST, _num_cell - GHOST, localStep);
+
+	// Coarsest level takes the largest step up to 2^(levels-1) smallest steps
+	if (setStep)
+	{
+		real_t minStep = std::numeric_limits<real_t>::max();
+		real_t maxStep = 0.0;
+		for (int_t icell = GHOST; icell < _num_cell - GHOST; ++icell)
+		{
+			minStep = std::min(minStep, _localStep[icell]);
+			maxStep = std::max(maxStep, _localStep[icell]);
+		}
+		_timeStep = std::min(minStep*real_t(1 << (_numLevel - 1)), maxStep);
+	}
+
+	// Coarsest level whose step is stable
+	for (int_t icell = GHOST; icell < _num_cell - GHOST; ++icell)
+	{
+		_level[icell] = 0;
+		while ((_level[icell] < _numLevel - 1) && (_timeStep / real_t(1 << _level[icell]) > _localStep[icell])) _level[icell]++;
+	}
+
+	// Neighboring cells differ by one level at most, levels only increase
+	bool changed = true;
+	while (changed)
+	{
+		changed = false;
+		for (int_t icell = GHOST; icell < _num_cell - GHOST; ++icell)
+		{
+			for (int_t direction = -1; direction <= 1; direction += 2)
+			{
+				int_t neighbor = getNeighbor(icell, direction);
+				if ((neighbor >= 0) && (_level[icell] < _level[neighbor] - 1)) { _level[icell] = _level[neighbor] - 1; changed = true; }
+			}
+		}
+	}
+
+	// Runs of every level
+	int_t maxLevel = 0;
+	for (int_t ilevel = 0; ilevel < _numLevel; ++ilevel) _run[ilevel].clear();
+	for (int_t icell = GHOST; icell < _num_cell - GHOST;)
+	{
+		int_t end = icell + 1;
+		while ((end < _num_cell - GHOST) && (_level[end] == _level[icell])) end++;
+		_run[_level[icell]].push_back(std::make_pair(icell, end));
+		maxLevel = std::max(maxLevel, _level[icell]);
+		icell = end;
+	}
+	_num_global += 3.0*(_num_cell - 2 * GHOST)*real_t(1 << maxLevel);
+}
+
+void TimeIntegLTS::marchLevel(std::shared_ptr<Zone> zone, int_t ilevel, real_t time, real_t timeStep)
+{
+	_levelTime[ilevel] = time;
+	const std::vector<std::pair<int_t, int_t> >& run = _run[ilevel];
+	std::shared_ptr<Zone>& temp_zone = _temp_zone;
+	const int_t polyOrder = zone->getPolyOrder();
+
+	// Stage times and weights of stage fluxes in the step
+	const real_t stageTime[3] = { time, time + timeStep, time + 0.5*timeStep };
+	const real_t weight[3] = { 1.0 / 6.0, 1.0 / 6.0, CONST23 };
+
+	// Cells of level start from solution Zone
+	for (size_t irun = 0; irun < run.size(); ++irun)
+	{
+		auto copyZone = [&](int_t begin, int_t end)
+		{
+			temp_zone->getDOF().assign(zone->getDOF(), begin, end);
+			temp_zone->calSolution(begin, end);
+		};
+		TIMER_SCOPE(Phase::Update);
+		ThreadPool::parallelFor(run[irun].first, run[irun].second, copyZone);
+	}
+
+	for (int_t istage = 0; istage < 3; ++istage)
+	{
+		if (run.empty()) break;
+
+		// Apply boundary condition with neighbors of stage time
+		setNeighbor(zone, ilevel, stageTime[istage]);
+		_bdry->apply(temp_zone);
+
+		// Apply hMLP limiter
+		for (size_t irun = 0; irun < run.size(); ++irun)
+			_limiter->hMLP_Limiter(temp_zone, run[irun].first, run[irun].second);
+
+		// Save previous degree of freedom
+		if (istage == 0)
+		{
+			auto savePrev = [&](int_t begin, int_t end) { _prev_DOF.assign(temp_zone->getDOF(), begin, end); };
+			TIMER_SCOPE(Phase::Update);
+			for (size_t irun = 0; irun < run.size(); ++irun)
+				ThreadPool::parallelFor(run[irun].first, run[irun].second, savePrev);
+		}
+
+		// Calculate RHS, fluxes of level interfaces are summed
+		const std::vector<real_t>& flux = _rhsKernel->getFlux();
+		auto sumFlux = [&](int_t face, int_t neighbor)
+		{
+			if (neighbor < 0) return;
+			if (_level[neighbor] > ilevel) _coarseFlux[face] += timeStep*weight[istage] * flux[face];
+			else if (_level[neighbor] < ilevel) _fineFlux[face] += timeStep*weight[istage] * flux[face];
+		};
+		for (size_t irun = 0; irun < run.size(); ++irun)
+		{
+			const int_t begin = run[irun].first;
+			const int_t end = run[irun].second;
+			computeRHS(temp_zone, _temp_RHS, begin, end);
+			sumFlux(begin, getNeighbor(begin, -1));
+			sumFlux(end, getNeighbor(end - 1, 1));
+			_num_update += end - begin;
+		}
+
+		// Calculate DOF of stage, the last stage updates solution Zone
+		auto stage = [&](int_t begin, int_t end)
+		{
+			for (int_t idegree = 0; idegree <= polyOrder; ++idegree)
+			{
+				if (istage == 0)
+				{
+					for (int_t icell = begin; icell < end; ++icell)
+						_temp_DOF[0](idegree, icell) = _prev_DOF(idegree, icell) + timeStep*_temp_RHS(idegree, icell);
+				}
+				else if (istage == 1)
+				{
+					for (int_t icell = begin; icell < end; ++icell)
+						_temp_DOF[1](idegree, icell) = 0.75*_prev_DOF(idegree, icell) + 0.25*(_temp_DOF[0](idegree, icell) + timeStep*_temp_RHS(idegree, icell));
+				}
+				else
+				{
+					for (int_t icell = begin; icell < end; ++icell)
+						zone->getDOF()(idegree, icell) = CONST13*_prev_DOF(idegree, icell) + CONST23*(_temp_DOF[1](idegree, icell) + timeStep*_temp_RHS(idegree, icell));
+				}
+			}
+			if (istage == 2) return;
+			temp_zone->getDOF().assign(_temp_DOF[istage], begin, end);
+			temp_zone->calSolution(begin, end);
+		};
+		TIMER_SCOPE(Phase::Update);
+		for (size_t irun = 0; irun < run.size(); ++irun)
+			ThreadPool::parallelFor(run[irun].first, run[irun].second, stage);
+	}
+
+	// Two half steps of finer level
+	if ((ilevel == _numLevel - 1) || _run[ilevel + 1].empty()) return;
+	marchLevel(zone, ilevel + 1, time, 0.5*timeStep);
+	marchLevel(zone, ilevel + 1, time + 0.5*timeStep, 0.5*timeStep);
+
+	// Fluxes of finer level replace the fluxes of this level on level interfaces
+	const real_t* inv_sizeX = zone->getGrid()->getInvSizeX().data();
+	const int_t* degree = zone->getDegree().data();
+	auto correct = [&](int_t icell, int_t face, int_t fineFace, bool left)
+	{
+		real_t jump = _fineFlux[fineFace] - _coarseFlux[face];
+		for (int_t idegree = 0; idegree <= degree[icell]; ++idegree)
+		{
+			real_t scale = DGbasis::legendreScale(idegree);
+			real_t sign = (idegree % 2 == 0) ? 1.0 : -1.0;
+			zone->getDOF()(idegree, icell) += inv_sizeX[icell] * (left ? sign*scale : -scale)*jump;
+		}
+		_fineFlux[fineFace] = 0.0;
+		_coarseFlux[face] = 0.0;
+	};
+	for (size_t irun = 0; irun < run.size(); ++irun)
+	{
+		const int_t begin = run[irun].first;
+		const int_t end = run[irun].second;
+		int_t neighbor = getNeighbor(begin, -1);
+		if ((neighbor >= 0) && (_level[neighbor] > ilevel)) correct(begin, begin, neighbor + 1, true);
+		neighbor = getNeighbor(end - 1, 1);
+		if ((neighbor >= 0) && (_level[neighbor] > ilevel)) correct(end - 1, end, neighbor, false);
+	}
+}
+
+int_t TimeIntegLTS::getNeighbor(int_t icell, int_t direction) const
+{
+	int_t neighbor = icell + direction;
+	if (neighbor < GHOST) return _periodic ? _num_cell - GHOST - 1 : -1;
+	if (neighbor >= _num_cell - GHOST) return _periodic ? GHOST : -1;
+	return neighbor;
+}
+
+void TimeIntegLTS::setNeighbor(std::shared_ptr<Zone> zone, int_t ilevel, real_t time)
+{
+	const int_t polyOrder = zone->getPolyOrder();
+	DOFArray& DOF = _temp_zone->getDOF();
+	const std::vector<std::pair<int_t, int_t> >& run = _run[ilevel];
+	for (size_t irun = 0; irun < run.size(); ++irun)
+	{
+		const int_t neighbor[2] = { getNeighbor(run[irun].first, -1), getNeighbor(run[irun].second - 1, 1) };
+		for (int_t iside = 0; iside < 2; ++iside)
+		{
+			const int_t icell = neighbor[iside];
+			if ((icell < 0) || (_level[icell] == ilevel)) continue;
+
+			// Coarser cell between start and end of its step, finer cell at start of this step
+			if (_level[icell] < ilevel)
+			{
+				real_t theta = (time - _levelTime[_level[icell]]) / (_timeStep / real_t(1 << _level[icell]));
+				for (int_t idegree = 0; idegree <= polyOrder; ++idegree)
+					DOF(idegree, icell) = (1.0 - theta)*_prev_DOF(idegree, icell) + theta*zone->getDOF()(idegree, icell);
+			}
+			else
+			{
+				for (int_t idegree = 0; idegree <= polyOrder; ++idegree)
+					DOF(idegree, icell) = zone->getDOF()(idegree, icell);
+			}
+			_temp_zone->calSolution(icell, icell + 1);
+		}
+	}
+}
\ No newline at end of file
@@ -0,0 +1,59 @@
+#pragma once
+#include "DataType.h"
+#include "TimeInteg.h"
+
+// Multirate TVD-RK3 with local time steps
+// Every step cells are grouped into levels by their own stable time step, level l marches with dt/2^l and
+// neighboring cells differ by one level at most. Levels march recursively : a level takes its step, then the next finer level two half steps.
+// Coarser neighbors of a stage are interpolated in time between the start and end of their step, finer neighbors stay at the start of the step.
+// Fluxes of level interfaces are summed with the RK3 weights(1/6, 1/6, 2/3) on both sides, the coarse cell takes the sum of the fine side
+// after the fine steps, so cell averages are conserved. The whole Zone is limited at the end of the step as in TimeIntegRK.
+// Single rank only.
+class TimeIntegLTS : public TimeInteg
+{
+public:
+	// Constructor / p.m. Equation type, flux type, limiter type, CFL number, target time, Zone(object), Boundary(object), number of levels
+	TimeIntegLTS(Type, Type, Type, real_t, real_t, std::shared_ptr<Zone>, std::shared_ptr<Boundary>, int_t);
+
+	// Destructor
+	virtual ~TimeIntegLTS();
+
+public:
+	// Functions
+	// Compute time integration / p.m. Zone(object) / r.t. go/stop
+	virtual bool march(std::shared_ptr<Zone>);
+
+protected:
+	// Variables
+	int_t _numLevel;
+	int_t _num_cell;
+	bool _periodic;
+	// Stage Zone, reused every step
+	std::shared_ptr<Zone> _temp_zone;
+	// Unlimited first and second stage
+	std::vector<DOFArray> _temp_DOF;
+	std::vector<real_t> _localStep; /// stable time step of every cell
+	std::vector<int_t> _level;
+	// Runs of contiguous real cells of every level / begin, end(exclusive)
+	std::vector<std::vector<std::pair<int_t, int_t> > > _run;
+	std::vector<real_t> _levelTime; /// start of current step of every level
+	// Weighted flux sums of level interfaces, face i is left of cell i
+	std::vector<real_t> _coarseFlux;
+	std::vector<real_t> _fineFlux;
+	real_t _num_update; /// cell stages computed
+	real_t _num_global; /// cell stages of global time step of finest level
+
+protected:
+	// Functions
+	// Stable time step of every cell, levels and runs / p.m. Zone(object), compute time step(or keep truncated one)
+	void computeLevel(std::shared_ptr<Zone>, bool);
+
+	// March one level and finer levels / p.m. Zone(object), level, start time, time step of level
+	void marchLevel(std::shared_ptr<Zone>, int_t, real_t, real_t);
+
+	// Real neighbor across a face, -1 on constant boundary / p.m. cell index, direction(-1 : left, 1 : right)
+	int_t getNeighbor(int_t, int_t) const;
+
+	// Neighbors of other levels at stage time / p.m. Zone(object), level, stage time
+	void setNeighbor(std::shared_ptr<Zone>, int_t, real_t);
+};
\ No newline at end of file
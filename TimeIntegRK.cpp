@@ -1,4 +1,6 @@
 #include "TimeIntegRK.h"
+#include "Timer.h"
+#include "Decomposition.h"
 
 TimeIntegRK::TimeIntegRK(Type PDEtype, Type fluxType, Type limiterType, real_t CFL, real_t targetTime, std::shared_ptr<Zone> zone, std::shared_ptr<Boundary> bdry, int_t RKorder)
 	:TimeInteg(PDEtype, fluxType, limiterType, CFL, targetTime, zone, bdry)
@@ -6,11 +8,8 @@ TimeIntegRK::TimeIntegRK(Type PDEtype, Type fluxType, Type limiterType, real_t C
 	_RKorder = RKorder;
 	_temp_DOF.resize(RKorder);
 	for (int_t iorder = 0; iorder < RKorder; ++iorder)
-	{
-		_temp_DOF[iorder].resize(zone->getPolyOrder() + 1);
-		for (int_t idegree = 0; idegree <= zone->getPolyOrder(); ++idegree)
-			_temp_DOF[iorder][idegree].resize(zone->getGrid()->getNumCell());
-	}
+		_temp_DOF[iorder] = DOFArray(zone->getPolyOrder() + 1, zone->getGrid()->getNumCell(), zone->getLayout());
+	_temp_zone = std::make_shared<Zone>(*zone);
 }
 
 TimeIntegRK::~TimeIntegRK()
@@ -22,7 +21,7 @@ bool TimeIntegRK::march(std::shared_ptr<Zone> zone)
 {
 	// Marching starts
 	bool procedure = true;
-	if (abs(_currentTime) < epsilon) MESSAGE("Marching starts.....");
+	if (std::abs(_currentTime) < epsilon) MESSAGE("Marching starts.....");
 
 	// Calculate time step
 	if ((_currentTime + _timeStep) > _targetTime)
@@ -32,83 +31,117 @@ bool TimeIntegRK::march(std::shared_ptr<Zone> zone)
 	}
 	else computeTimeStep(zone);
 
-	// Declare temprorary Zone for TVD Runge-Kutta time integration
-	std::shared_ptr<Zone> temp_zone = std::make_shared<Zone>(*zone);
-
-	// Declare local projection limiter object
-	std::shared_ptr<Limiter> limiter = std::make_shared<Limiter>(_limiterType, zone);
+	// Copy solution to temporary Zone for TVD Runge-Kutta time integration
+	std::shared_ptr<Zone>& temp_zone = _temp_zone;
+	const int_t num_cell = zone->getGrid()->getNumCell();
+	auto copyZone = [&](int_t begin, int_t end)
+	{
+		temp_zone->getDOF().assign(zone->getDOF(), begin, end);
+		std::copy(zone->getDescSolution().begin() + begin, zone->getDescSolution().begin() + end, temp_zone->getDescSolution().begin() + begin);
+	};
+	{
+		TIMER_SCOPE(Phase::Update);
+		ThreadPool::parallelFor(0, num_cell, copyZone);
+	}
+	if (zone->isAdaptiveOrder()) temp_zone->setDegree(zone->getDegree());
 
 	// ----------------------First step--------------------------
 	// Apply boundary condition
 	_bdry->apply(temp_zone);
 
 	// Apply hMLP limiter
-	limiter->hMLP_Limiter(temp_zone);
+	_limiter->hMLP_Limiter(temp_zone);
 
 	// Save previous degree of freedom
-	_prev_DOF = temp_zone->getDOF();
+	auto savePrev = [&](int_t begin, int_t end) { _prev_DOF.assign(temp_zone->getDOF(), begin, end); };
+	{
+		TIMER_SCOPE(Phase::Update);
+		ThreadPool::parallelFor(0, num_cell, savePrev);
+	}
 
 	// Calculate RHS
-	_temp_RHS = computeRHS(temp_zone);
+	computeRHS(temp_zone, _temp_RHS);
 
-	// Calculate DOF
-	for (int_t idegree = 0; idegree <= zone->getPolyOrder(); ++idegree)
+	// Calculate DOF and update temporary Zone object
+	auto firstStep = [&](int_t begin, int_t end)
+	{
+		for (int_t idegree = 0; idegree <= zone->getPolyOrder(); ++idegree)
+		{
+			for (int_t icell = begin; icell < end; ++icell)
+				_temp_DOF[0](idegree, icell) = _prev_DOF(idegree, icell) + _timeStep*_temp_RHS(idegree, icell);
+		}
+		temp_zone->getDOF().assign(_temp_DOF[0], begin, end);
+		temp_zone->calSolution(begin, end);
+	};
 	{
-		for (int_t icell = 0; icell < zone->getGrid()->getNumCell(); ++icell)
-			_temp_DOF[0][idegree][icell] = _prev_DOF[idegree][icell] + _timeStep*_temp_RHS[idegree][icell];
+		TIMER_SCOPE(Phase::Update);
+		ThreadPool::parallelFor(0, num_cell, firstStep);
 	}
 
-	// Update temporary Zone object
-	temp_zone->setDOF(_temp_DOF[0]);
-	temp_zone->calSolution();
-
 	// ---------------------Second step---------------------------
 	// Apply boundary condition
 	_bdry->apply(temp_zone);
 
 	// Apply hMLP limiter
-	limiter->hMLP_Limiter(temp_zone);
+	_limiter->hMLP_Limiter(temp_zone);
 
 	// Calculate RHS
-	_temp_RHS = computeRHS(temp_zone);
+	computeRHS(temp_zone, _temp_RHS);
 
-	// Calculate DOF
-	for (int_t idegree = 0; idegree <= zone->getPolyOrder(); ++idegree)
+	// Calculate DOF and update temporary Zone object
+	auto secondStep = [&](int_t begin, int_t end)
+	{
+		for (int_t idegree = 0; idegree <= zone->getPolyOrder(); ++idegree)
+		{
+			for (int_t icell = begin; icell < end; ++icell)
+				_temp_DOF[1](idegree, icell) = 0.75*_prev_DOF(idegree, icell) + 0.25*(_temp_DOF[0](idegree, icell) + _timeStep*_temp_RHS(idegree, icell));
+		}
+		temp_zone->getDOF().assign(_temp_DOF[1], begin, end);
+		temp_zone->calSolution(begin, end);
+	};
 	{
-		for (int_t icell = 0; icell < zone->getGrid()->getNumCell(); ++icell)
-			_temp_DOF[1][idegree][icell] = 0.75*_prev_DOF[idegree][icell] + 0.25*(_temp_DOF[0][idegree][icell] + _timeStep*_temp_RHS[idegree][icell]);
+		TIMER_SCOPE(Phase::Update);
+		ThreadPool::parallelFor(0, num_cell, secondStep);
 	}
 
-	// Update temporary Zone object
-	temp_zone->setDOF(_temp_DOF[1]);
-	temp_zone->calSolution();
-
 	// ----------------------Third step---------------------------
 	// Apply boundary condition
 	_bdry->apply(temp_zone);
 
 	// Apply hMLP limiter
-	limiter->hMLP_Limiter(temp_zone);
+	_limiter->hMLP_Limiter(temp_zone);
 
 	// Calculate RHS
-	_temp_RHS = computeRHS(temp_zone);
+	computeRHS(temp_zone, _temp_RHS);
 
-	// Calculate DOF
-	for (int_t idegree = 0; idegree <= zone->getPolyOrder(); ++idegree)
+	// Calculate DOF and update solution zone
+	auto thirdStep = [&](int_t begin, int_t end)
+	{
+		for (int_t idegree = 0; idegree <= zone->getPolyOrder(); ++idegree)
+		{
+			for (int_t icell = begin; icell < end; ++icell)
+				_temp_DOF[2](idegree, icell) = CONST13*_prev_DOF(idegree, icell) + CONST23*(_temp_DOF[1](idegree, icell) + _timeStep*_temp_RHS(idegree, icell));
+		}
+		zone->getDOF().assign(_temp_DOF[2], begin, end);
+	};
 	{
-		for (int_t icell = 0; icell < zone->getGrid()->getNumCell(); ++icell)
-			_temp_DOF[2][idegree][icell] = CONST13*_prev_DOF[idegree][icell] + CONST23*(_temp_DOF[1][idegree][icell] + _timeStep*_temp_RHS[idegree][icell]);
+		TIMER_SCOPE(Phase::Update);
+		ThreadPool::parallelFor(0, num_cell, thirdStep);
 	}
 
-	// Update solution zone
-	zone->setDOF(_temp_DOF[2]);
-
-	// Apply hMLP limiter
-	limiter->hMLP_Limiter(zone);
+	// Apply hMLP limiter, order of cells for next time step
+	_limiter->hMLP_Limiter(zone);
+	_limiter->adaptDegree(zone);
 
 	// Calculate solution
 	zone->calSolution();
 
+	// Ghost cells of rank interfaces for next time step
+	{
+		TIMER_SCOPE(Phase::Boundary);
+		Decomposition::exchange(zone);
+	}
+
 	// Update current time
 	_currentTime += _timeStep;
 
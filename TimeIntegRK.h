@@ -19,6 +19,8 @@ public:
 protected:
 	// Variables
 	int_t _RKorder;
+	// Stage Zone for TVD-RK, reused every step
+	std::shared_ptr<Zone> _temp_zone;
 	// temporary DOF for TVD-RK / RK order, DG degree, cell index
-	std::vector<std::vector<std::vector<real_t> > > _temp_DOF;
+	std::vector<DOFArray> _temp_DOF;
 };
\ No newline at end of file
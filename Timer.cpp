@@ -0,0 +1,317 @@
+// Standard headers before DataType.h (epsilon macro)
+#include <atomic>
+#include <chrono>
+#include <iomanip>
+#include <sstream>
+#if defined(RKDG_TIMING) && defined(RKDG_PERF_COUNTERS) && defined(__linux__)
+#define TIMER_PERF_EVENT
+#include <cerrno>
+#include <cstring>
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+#include "Timer.h"
+#include "Decomposition.h"
+#include "ThreadPool.h"
+
+static const int_t num_phase = int_t(Phase::NumPhase);
+static const int_t num_counter = int_t(Counter::NumCounter);
+
+// Totals of phases, nanoseconds and counts
+static std::atomic<int64_t> phase_total[int_t(Phase::NumPhase)][TIMER_NUM_VALUE];
+static int64_t wall_start = 0;
+
+// Counters opened by any thread, error of first refused counter
+static std::atomic<bool> counter_open[int_t(Counter::NumCounter)];
+static std::atomic<int> counter_error(0);
+
+// Innermost scope of every thread
+static thread_local ScopedTimer* active_timer = nullptr;
+
+#if defined(TIMER_PERF_EVENT)
+// Counter group of one thread, read at once through the group leader
+struct CounterGroup
+{
+	int leader;
+	int fd[int_t(Counter::NumCounter)];
+	int slot[int_t(Counter::NumCounter)]; /// position in group read, -1 : not counted
+	int num_open;
+
+	CounterGroup() : leader(-1), num_open(0)
+	{
+		static const uint64_t config[] = { PERF_COUNT_HW_CPU_CYCLES, PERF_COUNT_HW_INSTRUCTIONS, PERF_COUNT_HW_CACHE_MISSES, PERF_COUNT_HW_BRANCH_MISSES };
+		for (int_t icounter = 0; icounter < num_counter; ++icounter)
+		{
+			perf_event_attr attr;
+			std::memset(&attr, 0, sizeof(attr));
+			attr.type = PERF_TYPE_HARDWARE;
+			attr.size = sizeof(attr);
+			attr.config = config[icounter];
+			attr.disabled = (leader < 0);
+			attr.exclude_kernel = 1;
+			attr.exclude_hv = 1;
+			attr.read_format = PERF_FORMAT_GROUP;
+
+			// Calling thread on any CPU
+			fd[icounter] = int(syscall(__NR_perf_event_open, &attr, 0, -1, leader, 0));
+			slot[icounter] = -1;
+			if (fd[icounter] < 0)
+			{
+				int expected = 0;
+				counter_error.compare_exchange_strong(expected, errno);
+				continue;
+			}
+			if (leader < 0) leader = fd[icounter];
+			slot[icounter] = num_open++;
+			counter_open[icounter].store(true);
+		}
+		if (leader >= 0) ioctl(leader, PERF_EVENT_IOC_ENABLE, PERF_IOC_FLAG_GROUP);
+	}
+
+	~CounterGroup()
+	{
+		for (int_t icounter = 0; icounter < num_counter; ++icounter)
+			if (fd[icounter] >= 0) close(fd[icounter]);
+	}
+
+	// Counts of this thread / p.m. counts(output)
+	void read(int64_t* count) const
+	{
+		uint64_t buffer[1 + int_t(Counter::NumCounter)] = { 0 };
+		if ((leader < 0) || (::read(leader, buffer, sizeof(buffer)) <= 0)) return;
+		for (int_t icounter = 0; icounter < num_counter; ++icounter)
+			if (slot[icounter] >= 0) count[icounter] = int64_t(buffer[1 + slot[icounter]]);
+	}
+};
+#endif
+
+int64_t Timer::now()
+{
+	return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+void Timer::read(int64_t* value)
+{
+	for (int_t ivalue = 1; ivalue < TIMER_NUM_VALUE; ++ivalue) value[ivalue] = 0;
+#if defined(TIMER_PERF_EVENT)
+	// Opened on first use of every thread
+	static thread_local CounterGroup group;
+	group.read(value + 1);
+#endif
+	value[0] = now();
+}
+
+void Timer::add(Phase phase, const int64_t* value)
+{
+	for (int_t ivalue = 0; ivalue < TIMER_NUM_VALUE; ++ivalue)
+		phase_total[int_t(phase)][ivalue].fetch_add(value[ivalue], std::memory_order_relaxed);
+}
+
+ScopedTimer::ScopedTimer(Phase phase)
+{
+	_phase = phase;
+	for (int_t ivalue = 0; ivalue < TIMER_NUM_VALUE; ++ivalue) _inner[ivalue] = 0;
+	_outer = active_timer;
+	active_timer = this;
+	Timer::read(_start);
+}
+
+ScopedTimer::~ScopedTimer()
+{
+	int64_t elapsed[TIMER_NUM_VALUE];
+	Timer::read(elapsed);
+	for (int_t ivalue = 0; ivalue < TIMER_NUM_VALUE; ++ivalue) elapsed[ivalue] -= _start[ivalue];
+
+	int64_t exclusive[TIMER_NUM_VALUE];
+	for (int_t ivalue = 0; ivalue < TIMER_NUM_VALUE; ++ivalue) exclusive[ivalue] = elapsed[ivalue] - _inner[ivalue];
+	Timer::add(_phase, exclusive);
+	if (_outer != nullptr)
+		for (int_t ivalue = 0; ivalue < TIMER_NUM_VALUE; ++ivalue) _outer->_inner[ivalue] += elapsed[ivalue];
+	active_timer = _outer;
+}
+
+void Timer::start()
+{
+	for (int_t iphase = 0; iphase < num_phase; ++iphase)
+		for (int_t ivalue = 0; ivalue < TIMER_NUM_VALUE; ++ivalue) phase_total[iphase][ivalue].store(0);
+
+	// Open counters of this thread before marching
+	int64_t value[TIMER_NUM_VALUE];
+	read(value);
+#if defined(TIMER_PERF_EVENT)
+	if (counter_error.load() != 0)
+	{
+		const std::string reason = std::strerror(counter_error.load());
+		if (!hasCounters()) MESSAGE("Hardware counters unavailable (" + reason + "), timing only");
+		if (hasCounters()) MESSAGE("Some hardware counters unavailable (" + reason + ")");
+	}
+#endif
+	wall_start = now();
+}
+
+bool Timer::hasCounters()
+{
+	for (int_t icounter = 0; icounter < num_counter; ++icounter)
+		if (counter_open[icounter].load()) return true;
+	return false;
+}
+
+bool Timer::isEnabled()
+{
+#if defined(RKDG_TIMING)
+	return true;
+#else
+	return false;
+#endif
+}
+
+std::string Timer::getName(Phase phase)
+{
+	switch (phase)
+	{
+	case Phase::Boundary: return "boundary";
+	case Phase::Limiter: return "limiter";
+	case Phase::RHS: return "RHS";
+	case Phase::TimeStep: return "time step";
+	case Phase::Update: return "stage update";
+	case Phase::Solution: return "solution";
+	case Phase::Output: return "output";
+	case Phase::Checkpoint: return "checkpoint";
+	case Phase::Adaptation: return "adaptation";
+	default: return "";
+	}
+}
+
+std::string Timer::getName(Counter counter)
+{
+	switch (counter)
+	{
+	case Counter::Cycles: return "cycles";
+	case Counter::Instructions: return "instructions";
+	case Counter::CacheMisses: return "cache_misses";
+	case Counter::BranchMisses: return "branch_misses";
+	default: return "";
+	}
+}
+
+void Timer::summary(int_t num_step, int_t num_cell)
+{
+	if (!isEnabled()) return;
+
+	// Slowest rank of every phase
+	const real_t wall = Decomposition::maxAll(1.0e-9*(now() - wall_start));
+	std::vector<real_t> total(num_phase);
+	real_t sum = 0.0;
+	for (int_t iphase = 0; iphase < num_phase; ++iphase)
+	{
+		total[iphase] = Decomposition::maxAll(1.0e-9*phase_total[iphase][0].load());
+		sum += total[iphase];
+	}
+
+	// Counts of all ranks, counter is reported if any rank opened it
+	std::vector<std::vector<real_t> > count(num_phase, std::vector<real_t>(num_counter));
+	std::vector<bool> counted(num_counter);
+	bool anyCounter = false;
+	for (int_t icounter = 0; icounter < num_counter; ++icounter)
+	{
+		counted[icounter] = (Decomposition::maxAll(counter_open[icounter].load() ? 1.0 : 0.0) > 0.0);
+		anyCounter = anyCounter || counted[icounter];
+		for (int_t iphase = 0; iphase < num_phase; ++iphase)
+			count[iphase][icounter] = Decomposition::sumAll(real_t(phase_total[iphase][1 + icounter].load()));
+	}
+	if (!Decomposition::isRoot()) return;
+
+	const real_t stepRate = (wall > 0.0) ? num_step / wall : 0.0;
+	const real_t cellRate = stepRate*num_cell;
+	auto percent = [&](real_t time) { return (wall > 0.0) ? 100.0*time / wall : 0.0; };
+
+	// Text summary
+	std::ostringstream text;
+	text << std::fixed << std::setprecision(4);
+	text << "---------------- Timing ----------------\n";
+	text << std::left << std::setw(16) << "phase" << std::right << std::setw(12) << "time(s)" << std::setw(10) << "%" << "\n";
+	for (int_t iphase = 0; iphase < num_phase; ++iphase)
+		text << std::left << std::setw(16) << getName(Phase(iphase)) << std::right << std::setw(12) << total[iphase] << std::setw(10) << std::setprecision(1) << percent(total[iphase]) << std::setprecision(4) << "\n";
+	text << std::left << std::setw(16) << "other" << std::right << std::setw(12) << std::max(wall - sum, 0.0) << std::setw(10) << std::setprecision(1) << percent(std::max(wall - sum, 0.0)) << std::setprecision(4) << "\n";
+	text << std::left << std::setw(16) << "wall" << std::right << std::setw(12) << wall << "\n";
+	text << "Steps / s        = " << std::setprecision(2) << stepRate << "\n";
+	text << "Cell updates / s = " << std::scientific << cellRate << "\n";
+
+	// Counters, instructions per cycle and misses per thousand instructions
+	if (anyCounter)
+	{
+		const int_t cycles = int_t(Counter::Cycles);
+		const int_t instructions = int_t(Counter::Instructions);
+		text << std::left << std::setw(16) << "phase" << std::right;
+		for (int_t icounter = 0; icounter < num_counter; ++icounter) text << std::setw(15) << getName(Counter(icounter));
+		text << std::setw(8) << "IPC" << std::setw(12) << "cache/kI" << std::setw(12) << "branch/kI" << "\n";
+		for (int_t iphase = 0; iphase < num_phase; ++iphase)
+		{
+			const std::vector<real_t>& c = count[iphase];
+			text << std::left << std::setw(16) << getName(Phase(iphase)) << std::right << std::setprecision(3);
+			for (int_t icounter = 0; icounter < num_counter; ++icounter)
+			{
+				if (counted[icounter]) text << std::setw(15) << std::scientific << c[icounter];
+				else text << std::setw(15) << "n/a";
+			}
+			text << std::fixed << std::setprecision(2);
+			auto ratio = [&](int_t icounter, int_t base, real_t scale) -> std::string
+			{
+				if (!counted[icounter] || !counted[base] || (c[base] <= 0.0)) return "n/a";
+				std::ostringstream value;
+				value << std::fixed << std::setprecision(2) << scale*c[icounter] / c[base];
+				return value.str();
+			};
+			text << std::setw(8) << ratio(instructions, cycles, 1.0)
+				<< std::setw(12) << ratio(int_t(Counter::CacheMisses), instructions, 1000.0)
+				<< std::setw(12) << ratio(int_t(Counter::BranchMisses), instructions, 1000.0) << "\n";
+		}
+	}
+	std::cout << text.str();
+
+	// Machine-readable summary
+	std::string fileName = "./output/test/RKDG_1D_timing.json";
+	std::ofstream file;
+	file.open(fileName, std::ios::trunc);
+	if (!file.is_open()) ERROR("cannot open output file");
+	file.precision(9);
+	file << "{\n";
+	file << "  \"steps\": " << num_step << ",\n";
+	file << "  \"cells\": " << num_cell << ",\n";
+	file << "  \"threads\": " << ThreadPool::getNumThread() << ",\n";
+	file << "  \"ranks\": " << Decomposition::getSize() << ",\n";
+	file << "  \"wall\": " << wall << ",\n";
+	file << "  \"steps_per_second\": " << stepRate << ",\n";
+	file << "  \"cell_updates_per_second\": " << cellRate << ",\n";
+	file << "  \"phases\": {\n";
+	for (int_t iphase = 0; iphase < num_phase; ++iphase)
+		file << "    \"" << getName(Phase(iphase)) << "\": " << total[iphase] << ",\n";
+	file << "    \"other\": " << std::max(wall - sum, 0.0) << "\n";
+	file << "  },\n";
+
+	// Counters of phases, null without counters
+	if (!anyCounter) file << "  \"counters\": null\n";
+	else
+	{
+		file << "  \"counters\": {\n";
+		for (int_t iphase = 0; iphase < num_phase; ++iphase)
+		{
+			file << "    \"" << getName(Phase(iphase)) << "\": {";
+			for (int_t icounter = 0; icounter < num_counter; ++icounter)
+			{
+				file << " \"" << getName(Counter(icounter)) << "\": ";
+				if (counted[icounter]) file << int64_t(count[iphase][icounter]);
+				else file << "null";
+				file << ((icounter < num_counter - 1) ? "," : " ");
+			}
+			file << "}" << ((iphase < num_phase - 1) ? "," : "") << "\n";
+		}
+		file << "  }\n";
+	}
+	file << "}\n";
+	file.close();
+	MESSAGE("Timing summary : " + fileName);
+}
\ No newline at end of file
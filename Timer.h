@@ -0,0 +1,79 @@
+#pragma once
+#include <cstdint>
+#include "DataType.h"
+
+// Hot-path phase timers
+// Compiled with RKDG_TIMING : TIMER_SCOPE(phase) accumulates steady-clock time of the enclosing scope,
+// the summary prints per-phase totals, steps per second and cell updates per second and writes them as JSON.
+// Without RKDG_TIMING the scopes compile to nothing and the summary is empty.
+// Totals are atomic, phases may be timed on worker and writer threads.
+// Nested scopes are exclusive : time of an inner phase is taken out of the enclosing one, so phases add up to the wall time.
+//
+// Compiled with RKDG_TIMING and RKDG_PERF_COUNTERS on Linux : cycles, instructions, cache misses and branch misses
+// of every phase are counted through perf_event_open (user space only) and reported next to the times.
+// Counters are opened per thread and count the thread entering the scope, run with THREADS = 1 for whole-phase counts.
+// If the kernel refuses counters (containers, perf_event_paranoid) only times are reported.
+enum class Phase { Boundary, Limiter, RHS, TimeStep, Update, Solution, Output, Checkpoint, Adaptation, NumPhase };
+
+enum class Counter { Cycles, Instructions, CacheMisses, BranchMisses, NumCounter };
+
+#define TIMER_NUM_VALUE (1 + int_t(Counter::NumCounter)) /// time and counters
+
+class Timer
+{
+public:
+	// Functions
+	// Steady-clock time in nanoseconds
+	static int64_t now();
+
+	// Time and counters of this thread / p.m. values(output, TIMER_NUM_VALUE)
+	static void read(int64_t*);
+
+	// Accumulate time and counters of phase / p.m. phase, values(TIMER_NUM_VALUE)
+	static void add(Phase, const int64_t*);
+
+	// Clear totals and start wall clock of marching
+	static void start();
+
+	// Print summary and write JSON file / p.m. number of steps, number of cells updated by a step
+	static void summary(int_t, int_t);
+
+	// Name of phase / p.m. phase
+	static std::string getName(Phase);
+
+	// Name of counter / p.m. counter
+	static std::string getName(Counter);
+
+	static bool isEnabled();
+
+	// Hardware counters compiled in and accepted by the kernel
+	static bool hasCounters();
+};
+
+// Time of enclosing scope added to a phase
+class ScopedTimer
+{
+public:
+	// Constructor / p.m. phase
+	explicit ScopedTimer(Phase);
+
+	// Destructor
+	~ScopedTimer();
+
+protected:
+	// Variables
+	Phase _phase;
+	int64_t _start[TIMER_NUM_VALUE];
+	int64_t _inner[TIMER_NUM_VALUE]; /// time and counters of nested scopes
+	ScopedTimer* _outer; /// enclosing scope of this thread
+
+private:
+	ScopedTimer(const ScopedTimer&);
+	ScopedTimer& operator=(const ScopedTimer&);
+};
+
+#if defined(RKDG_TIMING)
+#define TIMER_SCOPE(phase) ScopedTimer timer_scope(phase)
+#else
+#define TIMER_SCOPE(phase)
+#endif
\ No newline at end of file
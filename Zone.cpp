@@ -1,12 +1,16 @@
 #include "Zone.h"
+#include "Timer.h"
 
 Zone::Zone(std::shared_ptr<Grid> grid)
 {
 	_grid = grid;
 	_polyOrder = 0;
 	_solution.resize(grid->getNumCell());
-	_DOF.resize(1);
-	_DOF[0].resize(grid->getNumCell());
+	_DOF = DOFArray(1, grid->getNumCell(), Layout::SoA);
+
+	_degree.assign(grid->getNumCell(), _polyOrder);
+	_adaptiveOrder = false;
+	_nodal = false;
 
 	// DG basis
 	_basis = std::make_shared<DGbasis>(_polyOrder, _grid);
@@ -22,9 +26,33 @@ Zone::Zone(std::shared_ptr<Grid> grid, int_t polyOrder)
 		ERROR("Polynomial order");
 
 	_solution.resize(grid->getNumCell());
-	_DOF.resize(polyOrder + 1);
-	for (int_t iorder = 0; iorder <= polyOrder; ++iorder)
-		_DOF[iorder].resize(grid->getNumCell());
+	_DOF = DOFArray(polyOrder + 1, grid->getNumCell(), Layout::SoA);
+
+	_degree.assign(grid->getNumCell(), _polyOrder);
+	_adaptiveOrder = false;
+	_nodal = false;
+
+	// DG basis
+	_basis = std::make_shared<DGbasis>(_polyOrder, _grid);
+}
+
+Zone::Zone(std::shared_ptr<Grid> grid, int_t polyOrder, Type layout)
+{
+	_grid = grid;
+	_polyOrder = polyOrder;
+
+	// Print error message if polynomial order is less than 0
+	if (_polyOrder < 0)
+		ERROR("Polynomial order");
+
+	_solution.resize(grid->getNumCell());
+	if (layout == "SoA") _DOF = DOFArray(polyOrder + 1, grid->getNumCell(), Layout::SoA);
+	else if (layout == "AoS") _DOF = DOFArray(polyOrder + 1, grid->getNumCell(), Layout::AoS);
+	else ERROR("cannot find DOF layout");
+
+	_degree.assign(grid->getNumCell(), _polyOrder);
+	_adaptiveOrder = false;
+	_nodal = false;
 
 	// DG basis
 	_basis = std::make_shared<DGbasis>(_polyOrder, _grid);
@@ -40,8 +68,8 @@ real_t Zone::getPolySolution(int_t icell, real_t x) const
 	real_t u = 0;
 	
 	// Calculate polynomial solution at x / beware of time level
-	for (int_t idegree = 0; idegree <= _polyOrder; ++idegree)
-		u += _basis->getCoeff()[idegree] * _DOF[idegree][icell] * _basis->basis(idegree, icell, x);
+	for (int_t idegree = 0; idegree <= _degree[icell]; ++idegree)
+		u += _basis->getCoeff(idegree, icell) * modalDOF(_DOF, idegree, icell) * _basis->basis(idegree, icell, x);
 
 	return u;
 }
@@ -51,7 +79,18 @@ real_t Zone::getPolySolution(int_t icell, real_t x, std::shared_ptr<Zone> zone)
 	real_t u = 0;
 	// Calculate polynomial solution at x / beware of time level
 	for (int_t idegree = 0; idegree <= _polyOrder; ++idegree)
-		u += _basis->getCoeff()[idegree] * zone->getDOF()[idegree][icell] * _basis->basis(idegree, icell, x);
+		u += _basis->getCoeff(idegree, icell) * modalDOF(zone->getDOF(), idegree, icell) * _basis->basis(idegree, icell, x);
+
+	return u;
+}
+
+real_t Zone::getProjectedSolution(int_t degree, int_t icell, real_t x) const
+{
+	real_t u = 0;
+
+	// Orthogonal basis : projection to lower degree truncates higher modes
+	for (int_t idegree = 0; idegree <= std::min(degree, _polyOrder); ++idegree)
+		u += _basis->getCoeff(idegree, icell) * modalDOF(_DOF, idegree, icell) * _basis->basis(idegree, icell, x);
 
 	return u;
 }
@@ -61,37 +100,120 @@ void Zone::initialize(std::shared_ptr<InitialCondition> initialCondition)
 	// Temporary cell object
 	std::vector<std::shared_ptr<Cell> > temp_cell = _grid->getCell();
 
-	// Grid size
-	real_t temp_dx = _grid->getSizeX();
-
-	// Initializing Degree of freedom
+	// Initializing Degree of freedom, quadrature of polynomial order
+	const int_t num_quad = Quadrature::numPoint(_polyOrder);
 	for (int_t icell = 0; icell < _grid->getNumCell(); ++icell)
 	{
 		real_t temp_x = temp_cell[icell]->getPosX();
+		real_t temp_dx = temp_cell[icell]->getSizeX();
 		for (int_t iorder = 0; iorder <= _polyOrder; ++iorder)
 		{
-			_DOF[iorder][icell] = 0.0;
-			for (int_t idegree = 0; idegree < QuadDegree; ++idegree)
+			_DOF(iorder, icell) = 0.0;
+			for (int_t idegree = 0; idegree < num_quad; ++idegree)
 			{
-				_DOF[iorder][icell] += Gauss3_W(idegree)*initialCondition->initializer(temp_x + 0.5*temp_dx*Gauss3_X(idegree))
-					*_basis->basis(iorder, icell, temp_x + 0.5*temp_dx*Gauss3_X(idegree))*0.5;
+				_DOF(iorder, icell) += Gauss_W(num_quad, idegree)*initialCondition->initializer(temp_x + 0.5*temp_dx*Gauss_X(num_quad, idegree))
+					*_basis->basis(iorder, icell, temp_x + 0.5*temp_dx*Gauss_X(num_quad, idegree))*0.5;
 			}
-			_DOF[iorder][icell] /= pow(temp_dx, iorder);
+			_DOF(iorder, icell) /= pow(temp_dx, iorder);
 		}
 	}
 
+	// Values at nodes of nodal Zone
+	if (_nodal)
+	{
+		_nodal = false;
+		setNodal(true);
+	}
+
 	// Calculate solution
 	calSolution();
 }
 
+void Zone::project(int_t icell, std::shared_ptr<Zone> source, int_t first, int_t last)
+{
+	real_t temp_x = _grid->getCell()[icell]->getPosX();
+	real_t temp_dx = _grid->getCell()[icell]->getSizeX();
+	for (int_t iorder = 0; iorder <= _polyOrder; ++iorder)
+		_DOF(iorder, icell) = 0.0;
+
+	// Quadrature on the part of every source cell inside the cell
+	const int_t num_quad = Quadrature::numPoint(_polyOrder);
+	for (int_t jcell = first; jcell <= last; ++jcell)
+	{
+		const std::shared_ptr<Cell>& cell = source->getGrid()->getCell()[jcell];
+		real_t begin = std::max(temp_x - 0.5*temp_dx, cell->getPosX() - 0.5*cell->getSizeX());
+		real_t end = std::min(temp_x + 0.5*temp_dx, cell->getPosX() + 0.5*cell->getSizeX());
+		if (end <= begin) continue;
+		for (int_t idegree = 0; idegree < num_quad; ++idegree)
+		{
+			real_t x = 0.5*(begin + end) + 0.5*(end - begin)*Gauss_X(num_quad, idegree);
+			real_t u = source->getPolySolution(jcell, x);
+			for (int_t iorder = 0; iorder <= _polyOrder; ++iorder)
+				_DOF(iorder, icell) += Gauss_W(num_quad, idegree)*u*_basis->basis(iorder, icell, x)*0.5*(end - begin) / temp_dx;
+		}
+	}
+
+	for (int_t iorder = 0; iorder <= _polyOrder; ++iorder)
+		_DOF(iorder, icell) /= pow(temp_dx, iorder);
+}
+
+void Zone::setNodal(bool nodal)
+{
+	if (nodal == _nodal) return;
+	if (nodal && (_polyOrder == 0)) ERROR("nodal basis needs polynomial order 1 or higher");
+
+	// Transform matrices of Gauss-Lobatto nodes
+	const int_t num_mode = _polyOrder + 1;
+	if (_toNodal.empty())
+	{
+		_toNodal.resize(num_mode*num_mode);
+		_toModal.resize(num_mode*num_mode);
+		for (int_t inode = 0; inode < num_mode; ++inode)
+		{
+			for (int_t idegree = 0; idegree < num_mode; ++idegree)
+			{
+				_toNodal[inode*num_mode + idegree] = DGbasis::modeAtNode(_polyOrder, idegree, inode);
+				_toModal[idegree*num_mode + inode] = DGbasis::nodeToMode(_polyOrder, idegree, inode);
+			}
+		}
+	}
+
+	// DOF of every cell, ghost cells included
+	const std::vector<real_t>& matrix = nodal ? _toNodal : _toModal;
+	auto transform = [&](int_t begin, int_t end)
+	{
+		real_t temp[MAX_QUAD]; /// nodes are Gauss-Lobatto points, at most MAX_QUAD
+		for (int_t icell = begin; icell < end; ++icell)
+		{
+			for (int_t i = 0; i < num_mode; ++i)
+			{
+				temp[i] = 0.0;
+				for (int_t j = 0; j < num_mode; ++j)
+					temp[i] += matrix[i*num_mode + j] * _DOF(j, icell);
+			}
+			for (int_t i = 0; i < num_mode; ++i)
+				_DOF(i, icell) = temp[i];
+		}
+	};
+	ThreadPool::parallelFor(0, _grid->getNumCell(), transform);
+	_nodal = nodal;
+}
+
 void Zone::calSolution()
 {
-	for (int_t icell = 0; icell < _grid->getNumCell(); ++icell)
+	TIMER_SCOPE(Phase::Solution);
+	auto body = [this](int_t begin, int_t end) { calSolution(begin, end); };
+	ThreadPool::parallelFor(0, _grid->getNumCell(), body);
+}
+
+void Zone::calSolution(int_t begin, int_t end)
+{
+	for (int_t icell = begin; icell < end; ++icell)
 	{
 		_solution[icell] = 0.0;
-		for (int_t iorder = 0; iorder <= _polyOrder; ++iorder)
+		for (int_t iorder = 0; iorder <= _degree[icell]; ++iorder)
 		{
-			_solution[icell] += _basis->getCoeff()[iorder] * _DOF[iorder][icell] * _basis->basis(iorder, icell, _grid->getCell()[icell]->getPosX());
+			_solution[icell] += _basis->getCoeff(iorder, icell) * modalDOF(_DOF, iorder, icell) * _basis->basis(iorder, icell, _grid->getCell()[icell]->getPosX());
 		}
 	}
 }
@@ -108,7 +230,7 @@ void Zone::print() const
 	{
 		std::cout << std::to_string(_grid->getCell()[icell]->getPosX()) << "\t\t" << std::to_string(_solution[icell]) << "\t\t";
 		for (int_t iorder = 0; iorder <= _polyOrder; ++iorder)
-			std::cout << std::to_string(_DOF[iorder][icell]) << "\t\t";
+			std::cout << std::to_string(_DOF(iorder, icell)) << "\t\t";
 		std::cout << "\n";
 	}
 }
\ No newline at end of file
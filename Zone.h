@@ -4,6 +4,8 @@
 #include "InitialCondition.h"
 #include "Quadrature.h"
 #include "DGbasis.h"
+#include "DOFArray.h"
+#include "ThreadPool.h"
 
 class Zone
 {
@@ -14,6 +16,9 @@ public:
 	// Constructor / p.m. Grid(object), DG polynomial order
 	Zone(std::shared_ptr<Grid>, int_t);
 
+	// Constructor / p.m. Grid(object), DG polynomial order, DOF layout(SoA or AoS)
+	Zone(std::shared_ptr<Grid>, int_t, Type);
+
 	// Destructor
 	~Zone();
 
@@ -22,16 +27,44 @@ public:
 	inline std::shared_ptr<Grid> getGrid() const { return _grid; }
 
 	// Get Descrete solution
-	inline std::vector<real_t> getDescSolution() const { return _solution; }
+	inline const std::vector<real_t>& getDescSolution() const { return _solution; }
+
+	inline std::vector<real_t>& getDescSolution() { return _solution; }
+
+	// Get DOF storage / DOF[mode][cell] view without copy
+	inline const DOFArray& getDOF() const { return _DOF; }
 
-	inline std::vector<std::vector<real_t> > getDOF() const { return _DOF; }
+	inline DOFArray& getDOF() { return _DOF; }
+
+	inline Layout getLayout() const { return _DOF.getLayout(); }
 
 	inline int_t getPolyOrder() const { return _polyOrder; }
 
+	// Polynomial order of every cell, modes above it are zero / ghost cells keep the order of Zone
+	inline const std::vector<int_t>& getDegree() const { return _degree; }
+
+	inline std::vector<int_t>& getDegree() { return _degree; }
+
+	inline void setDegree(const std::vector<int_t>& degree) { _degree = degree; }
+
+	// Order of cells follows the hMLP limiter
+	inline bool isAdaptiveOrder() const { return _adaptiveOrder; }
+
+	inline void setAdaptiveOrder(bool adaptive) { _adaptiveOrder = adaptive; }
+
+	// DOF are values at Gauss-Lobatto nodes of cells instead of modal coefficients
+	inline bool isNodal() const { return _nodal; }
+
+	// Switch DOF representation, DOF of all cells are transformed / p.m. nodal or modal
+	void setNodal(bool);
+
+	// Modal DOF in either representation / p.m. degree, cell index
+	inline real_t getModalDOF(int_t degree, int_t icell) const { return modalDOF(_DOF, degree, icell); }
+
 	// Set Descrete solution
-	inline void setDescSolution(std::vector<real_t> solution) { _solution = solution; }
+	inline void setDescSolution(const std::vector<real_t>& solution) { _solution = solution; }
 
-	inline void setDOF(std::vector<std::vector<real_t> > DOF) { _DOF = DOF; }
+	inline void setDOF(const DOFArray& DOF) { _DOF.assign(DOF); }
 
 	// Get polynomial solution at coordinate x / p.m. cell index, x coordinate
 	real_t getPolySolution(int_t, real_t) const;
@@ -39,12 +72,21 @@ public:
 	// Get polynomial solution at coordinate x from specific Zone / p.m. cell index, x coordinate, Zone(object)
 	real_t getPolySolution(int_t, real_t, std::shared_ptr<Zone>) const;
 
+	// Get polynomial solution projected to lower degree at coordinate x / p.m. degree of projected P, cell index, x coordinate
+	real_t getProjectedSolution(int_t, int_t, real_t) const;
+
 	// Initialize solution / p.m. Initial condition(object)
 	void initialize(std::shared_ptr<InitialCondition>);
 
+	// L2 projection of solution of another Zone / p.m. cell index, source Zone(object), first and last source cell overlapping the cell
+	void project(int_t, std::shared_ptr<Zone>, int_t, int_t);
+
 	// Calculate Descrete solution from DOF
 	void calSolution();
 
+	// Calculate Descrete solution from DOF in cell range / p.m. begin cell, end cell(exclusive)
+	void calSolution(int_t, int_t);
+
 	// Print Solution variables
 	void print() const;
 
@@ -53,6 +95,23 @@ protected:
 	std::shared_ptr<Grid> _grid;
 	std::shared_ptr<DGbasis> _basis;
 	std::vector<real_t> _solution;
-	std::vector<std::vector<real_t> > _DOF;
+	DOFArray _DOF;
 	int_t _polyOrder;
+	std::vector<int_t> _degree;
+	bool _adaptiveOrder;
+	bool _nodal;
+	std::vector<real_t> _toNodal; /// [node][degree]
+	std::vector<real_t> _toModal; /// [degree][node]
+
+protected:
+	// Functions
+	// Modal DOF of DOF storage in representation of Zone / p.m. DOF, degree, cell index
+	inline real_t modalDOF(const DOFArray& DOF, int_t degree, int_t icell) const
+	{
+		if (!_nodal) return DOF(degree, icell);
+		real_t mode = 0.0;
+		for (int_t inode = 0; inode <= _polyOrder; ++inode)
+			mode += _toModal[degree*(_polyOrder + 1) + inode] * DOF(inode, icell);
+		return mode;
+	}
 };
\ No newline at end of file
@@ -0,0 +1,250 @@
+// Standard headers before DataType.h (epsilon macro)
+#include <chrono>
+#include <functional>
+#include <iomanip>
+#include <random>
+#include <sstream>
+
+#include "../DataType.h"
+#include "../Grid.h"
+#include "../Zone.h"
+#include "../InitialCondition.h"
+#include "../Boundary.h"
+#include "../Limiter.h"
+#include "../ConvFluxGodunov.h"
+#include "../RHSKernel.h"
+#include "../TimeIntegRK.h"
+#include "../ThreadPool.h"
+
+// Microbenchmarks of solver kernels
+// Every kernel runs on a fresh grid for each polynomial order and cell count.
+// A sample times a batch of calls, the batch is sized to run at least the minimum sample time.
+// Setup between calls (restoring limited or marched DOF) is not timed.
+// Results are ns per cell : median, minimum, mean and relative standard deviation of the samples.
+
+// Options of command line
+struct Option
+{
+	std::vector<int_t> num_cell;
+	std::vector<int_t> polyOrder;
+	Type PDE;
+	Type kernel; /// run kernels whose name contains this, "" : all
+	int_t num_sample;
+	int_t num_thread;
+	real_t sampleTime; /// seconds
+	std::string csv;
+};
+
+// Statistics of one kernel / ns per cell
+struct Result
+{
+	real_t median;
+	real_t min;
+	real_t mean;
+	real_t stddev;
+	int_t num_call; /// calls per sample
+};
+
+// Kernel under test : setup(untimed) and body(timed)
+struct Kernel
+{
+	std::string name;
+	std::function<void()> setup;
+	std::function<void()> body;
+};
+
+static real_t seconds(std::chrono::steady_clock::duration time)
+{
+	return std::chrono::duration<real_t>(time).count();
+}
+
+// Comma separated integers
+static std::vector<int_t> parseList(const std::string& text)
+{
+	std::vector<int_t> list;
+	std::stringstream stream(text);
+	std::string item;
+	while (std::getline(stream, item, ',')) list.push_back(std::stoi(item));
+	return list;
+}
+
+static Result measure(const Kernel& kernel, int_t num_cell, const Option& option)
+{
+	typedef std::chrono::steady_clock clock;
+
+	// Time of one call, including first-touch and warm-up
+	clock::duration elapsed = clock::duration::zero();
+	int_t num_call = 0;
+	while ((seconds(elapsed) < 0.2*option.sampleTime) || (num_call < 2))
+	{
+		kernel.setup();
+		clock::time_point start = clock::now();
+		kernel.body();
+		elapsed += clock::now() - start;
+		num_call++;
+	}
+	const int_t batch = std::max(int_t(1), int_t(option.sampleTime / (seconds(elapsed) / num_call)));
+
+	// Samples
+	std::vector<real_t> sample(option.num_sample);
+	for (int_t isample = 0; isample < option.num_sample; ++isample)
+	{
+		elapsed = clock::duration::zero();
+		for (int_t icall = 0; icall < batch; ++icall)
+		{
+			kernel.setup();
+			clock::time_point start = clock::now();
+			kernel.body();
+			elapsed += clock::now() - start;
+		}
+		sample[isample] = 1.0e9*seconds(elapsed) / batch / num_cell;
+	}
+
+	Result result;
+	result.num_call = batch;
+	std::sort(sample.begin(), sample.end());
+	const int_t half = option.num_sample / 2;
+	result.median = (option.num_sample % 2 == 1) ? sample[half] : 0.5*(sample[half - 1] + sample[half]);
+	result.min = sample.front();
+	result.mean = 0.0;
+	for (real_t value : sample) result.mean += value;
+	result.mean /= option.num_sample;
+	result.stddev = 0.0;
+	for (real_t value : sample) result.stddev += (value - result.mean)*(value - result.mean);
+	result.stddev = (option.num_sample > 1) ? sqrt(result.stddev / (option.num_sample - 1)) : 0.0;
+	return result;
+}
+
+// Kernels of one polynomial order and grid
+static void run(const Option& option, int_t polyOrder, int_t num_cell, std::ostream& csv)
+{
+	const real_t area = 2.0;
+	std::shared_ptr<Grid> grid = std::make_shared<Grid>(area, area / num_cell);
+	const int_t num_all = grid->getNumCell();
+	const int_t num_real = grid->getNumGlobalCell();
+
+	// Smooth and discontinuous solutions, saved for untimed restore
+	std::shared_ptr<Zone> smooth = std::make_shared<Zone>(grid, polyOrder);
+	smooth->initialize(std::make_shared<InitialCondition>("sine"));
+	std::shared_ptr<Zone> jump = std::make_shared<Zone>(grid, polyOrder);
+	jump->initialize(std::make_shared<InitialCondition>("square"));
+
+	// Random modes of fixed seed, most cells reach the extrema detector and the projection
+	std::shared_ptr<Zone> random = std::make_shared<Zone>(*smooth);
+	std::mt19937 generator(polyOrder*num_cell + 1);
+	std::uniform_real_distribution<real_t> distribution(-1.0, 1.0);
+	for (int_t icell = 0; icell < num_all; ++icell)
+		for (int_t idegree = 0; idegree <= polyOrder; ++idegree)
+			random->getDOF()(idegree, icell) = distribution(generator) / (idegree + 1);
+	random->calSolution();
+	std::shared_ptr<Zone> zone = std::make_shared<Zone>(*smooth);
+	auto restore = [&](std::shared_ptr<Zone> source)
+	{
+		zone->getDOF().assign(source->getDOF(), 0, num_all);
+		zone->getDescSolution() = source->getDescSolution();
+	};
+
+	std::shared_ptr<Boundary> bdry = std::make_shared<Boundary>("periodic", zone);
+	std::shared_ptr<Limiter> limiter = std::make_shared<Limiter>("MLP-u2", zone);
+	std::shared_ptr<ConvFluxGodunov> flux = std::make_shared<ConvFluxGodunov>(option.PDE, zone);
+	std::shared_ptr<RHSKernel> rhsKernel = RHSKernel::create(polyOrder, option.PDE, "godunov", num_all);
+	DOFArray RHS(polyOrder + 1, num_all, zone->getLayout());
+
+	// Smooth solution in nodal DOF for nodal RHS kernel, P1 or higher
+	std::shared_ptr<Zone> nodal = std::make_shared<Zone>(*smooth);
+	std::shared_ptr<RHSKernel> nodalKernel;
+	if (polyOrder > 0)
+	{
+		nodal->setNodal(true);
+		nodalKernel = RHSKernel::createNodal(polyOrder, option.PDE, "godunov", num_all);
+	}
+	std::shared_ptr<TimeInteg> timeInteg = std::make_shared<TimeIntegRK>(option.PDE, "godunov", "MLP-u2", 0.1, 1.0e30, zone, bdry, 3);
+
+	// Face states of smooth solution for flux kernel
+	std::vector<real_t> left(num_all - 1), right(num_all - 1);
+	for (int_t iface = 0; iface < num_all - 1; ++iface)
+	{
+		left[iface] = smooth->getPolySolution(iface, grid->getCell()[iface]->getPosX() + 0.5*grid->getCell()[iface]->getSizeX());
+		right[iface] = smooth->getPolySolution(iface + 1, grid->getCell()[iface + 1]->getPosX() - 0.5*grid->getCell()[iface + 1]->getSizeX());
+	}
+	volatile real_t sink = 0.0;
+
+	auto none = [] {};
+	std::vector<Kernel> kernel =
+	{
+		{ "flux", none, [&] { real_t sum = 0.0; for (int_t iface = 0; iface < num_all - 1; ++iface) sum += flux->computeFlux(left[iface], right[iface]); sink = sum; } },
+		{ "RHS", none, [&] { rhsKernel->compute(zone, RHS); } },
+		{ "RHS nodal", none, [&] { nodalKernel->compute(nodal, RHS); } },
+		{ "limiter smooth", [&] { restore(smooth); }, [&] { limiter->hMLP_Limiter(zone); } },
+		{ "limiter jump", [&] { restore(jump); }, [&] { limiter->hMLP_Limiter(zone); } },
+		{ "limiter random", [&] { restore(random); }, [&] { limiter->hMLP_Limiter(zone); } },
+		{ "calSolution", none, [&] { zone->calSolution(); } },
+		{ "boundary", none, [&] { bdry->apply(zone); } },
+		{ "RK3 march", [&] { restore(smooth); timeInteg->reset(); }, [&] { timeInteg->march(zone); } },
+	};
+
+	for (const Kernel& test : kernel)
+	{
+		if ((option.kernel != "") && (test.name.find(option.kernel) == std::string::npos)) continue;
+		if ((test.name == "RHS nodal") && (nodalKernel == nullptr)) continue;
+		restore(smooth);
+		Result result = measure(test, num_real, option);
+
+		std::cout << std::left << std::setw(16) << test.name << std::right << std::setw(3) << polyOrder << std::setw(10) << num_real
+			<< std::fixed << std::setprecision(3) << std::setw(12) << result.median << std::setw(12) << result.min << std::setw(12) << result.mean
+			<< std::setprecision(1) << std::setw(8) << ((result.mean > 0.0) ? 100.0*result.stddev / result.mean : 0.0) << std::setw(10) << result.num_call << "\n";
+		csv << test.name << "," << polyOrder << "," << num_real << "," << result.median << "," << result.min << "," << result.mean << "," << result.stddev << "," << result.num_call << "\n";
+	}
+}
+
+int main(int argc, char* argv[])
+{
+	Option option;
+	option.num_cell = { 100, 1000, 10000 };
+	option.polyOrder = { 0, 1, 2 };
+	option.PDE = "burgers";
+	option.kernel = "";
+	option.num_sample = 11;
+	option.num_thread = 1;
+	option.sampleTime = 0.01;
+
+	for (int iarg = 1; iarg + 1 < argc; iarg += 2)
+	{
+		std::string key = argv[iarg];
+		std::string value = argv[iarg + 1];
+		if (key == "--cells") option.num_cell = parseList(value);
+		else if (key == "--order") option.polyOrder = parseList(value);
+		else if (key == "--pde") option.PDE = value;
+		else if (key == "--kernel") option.kernel = value;
+		else if (key == "--samples") option.num_sample = std::stoi(value);
+		else if (key == "--threads") option.num_thread = std::stoi(value);
+		else if (key == "--time") option.sampleTime = std::stod(value);
+		else if (key == "--csv") option.csv = value;
+		else ERROR("unknown option " + key);
+	}
+	if (option.num_sample < 1) ERROR("number of samples");
+
+	// Kernels only, no solver messages
+	if (option.PDE == "advection") SET_SPEED(1.0);
+	ThreadPool::setNumThread(ThreadPool::select(option.num_thread));
+	Alert::setSilent(true);
+
+	std::ofstream csv;
+	std::ostringstream discard;
+	if (option.csv != "")
+	{
+		csv.open(option.csv, std::ios::trunc);
+		if (!csv.is_open()) ERROR("cannot open output file");
+		csv << "kernel,P,cells,median,min,mean,stddev,calls\n";
+		csv.precision(9);
+	}
+
+	std::cout << "PDE = " << option.PDE << ", threads = " << ThreadPool::getNumThread() << ", " << option.num_sample << " samples of " << option.sampleTime << " s, ns/cell\n";
+	std::cout << std::left << std::setw(16) << "kernel" << std::right << std::setw(3) << "P" << std::setw(10) << "cells"
+		<< std::setw(12) << "median" << std::setw(12) << "min" << std::setw(12) << "mean" << std::setw(8) << "sd(%)" << std::setw(10) << "calls" << "\n";
+	for (int_t polyOrder : option.polyOrder)
+		for (int_t num_cell : option.num_cell)
+			run(option, polyOrder, num_cell, csv.is_open() ? static_cast<std::ostream&>(csv) : static_cast<std::ostream&>(discard));
+
+	return 0;
+}
\ No newline at end of file
@@ -0,0 +1,235 @@
+// Standard headers before DataType.h (epsilon macro)
+#include <chrono>
+#include <iomanip>
+#include <map>
+#include <sstream>
+#include <thread>
+#include <tuple>
+
+#include "../DataType.h"
+#include "../Grid.h"
+#include "../Zone.h"
+#include "../InitialCondition.h"
+#include "../Boundary.h"
+#include "../TimeIntegRK.h"
+#include "../ThreadPool.h"
+
+// End-to-end scaling of the full solver
+// Canonical scenarios march RK3 steps on grids of the requested sizes with the requested thread counts.
+// strong : fixed grid for every thread count, weak : cells per thread fixed.
+// Throughput is cell updates per second(cells x steps / wall time), the best of repeated runs is kept.
+// Results are written as CSV. With a baseline file the harness fails(exit code 1)
+// when throughput of any configuration in the baseline drops by more than the tolerance.
+
+// Canonical scenario
+struct Scenario
+{
+	std::string name;
+	Type PDE;
+	Type initial;
+	Type limiter;
+	int_t polyOrder;
+};
+
+// One configuration and its throughput
+struct Run
+{
+	std::string scenario;
+	std::string mode;
+	int_t num_thread;
+	int_t num_cell;
+	int_t num_step;
+	real_t wall;
+	real_t throughput; /// cell updates per second
+	real_t efficiency; /// throughput per thread relative to first thread count
+};
+
+// Options of command line
+struct Option
+{
+	std::vector<int_t> num_cell;
+	std::vector<int_t> num_thread;
+	std::vector<std::string> mode;
+	std::string scenario; /// run scenarios whose name contains this, "" : all
+	real_t work; /// cell updates per run
+	int_t repeat;
+	real_t tolerance; /// allowed throughput drop in percent
+	std::string csv;
+	std::string baseline;
+};
+
+typedef std::tuple<std::string, std::string, int_t, int_t> Key; /// scenario, mode, threads, cells
+
+// Comma separated values
+static std::vector<std::string> split(const std::string& text)
+{
+	std::vector<std::string> list;
+	std::stringstream stream(text);
+	std::string item;
+	while (std::getline(stream, item, ',')) list.push_back(item);
+	return list;
+}
+
+static std::vector<int_t> parseList(const std::string& text)
+{
+	std::vector<int_t> list;
+	for (const std::string& item : split(text)) list.push_back(int_t(std::stod(item)));
+	return list;
+}
+
+// March steps of scenario / p.m. scenario, number of cells, number of steps / r.t. wall time
+static real_t march(const Scenario& scenario, int_t num_cell, int_t num_step)
+{
+	const real_t area = 2.0;
+	std::shared_ptr<Grid> grid = std::make_shared<Grid>(area, area / num_cell);
+	std::shared_ptr<Zone> zone = std::make_shared<Zone>(grid, scenario.polyOrder);
+	zone->initialize(std::make_shared<InitialCondition>(scenario.initial));
+	std::shared_ptr<Boundary> bdry = std::make_shared<Boundary>("periodic", zone);
+	std::shared_ptr<TimeInteg> timeInteg = std::make_shared<TimeIntegRK>(scenario.PDE, "godunov", scenario.limiter, 0.9, 1.0e30, zone, bdry, 3);
+
+	// First step touches work arrays
+	timeInteg->march(zone);
+
+	std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+	for (int_t istep = 0; istep < num_step; ++istep) timeInteg->march(zone);
+	return std::chrono::duration<real_t>(std::chrono::steady_clock::now() - start).count();
+}
+
+static std::map<Key, real_t> readBaseline(const std::string& fileName)
+{
+	std::map<Key, real_t> baseline;
+	std::ifstream file(fileName);
+	if (!file.is_open()) ERROR("cannot open baseline file");
+
+	// Same columns as CSV output, '#' comment lines
+	std::string text;
+	std::getline(file, text);
+	while (std::getline(file, text))
+	{
+		if (!text.empty() && (text.back() == '\r')) text.pop_back();
+		if (text.empty() || (text[0] == '#')) continue;
+		std::vector<std::string> column = split(text);
+		if (column.size() < 7) ERROR("baseline file format");
+		baseline[Key(column[0], column[1], std::stoi(column[2]), std::stoi(column[3]))] = std::stod(column[6]);
+	}
+	return baseline;
+}
+
+int main(int argc, char* argv[])
+{
+	const std::vector<Scenario> scenario =
+	{
+		{ "sine-P2", "advection", "sine", "MLP-u2", 2 },
+		{ "square-P2", "advection", "square", "MLP-u2", 2 },
+		{ "shock-P2", "burgers", "shock", "MLP-u2", 2 },
+	};
+
+	Option option;
+	option.num_cell = { 1000, 10000, 100000, 1000000, 10000000 };
+	option.num_thread = { 1 };
+	if (std::thread::hardware_concurrency() > 1) option.num_thread.push_back(std::thread::hardware_concurrency());
+	option.mode = { "strong", "weak" };
+	option.scenario = "";
+	option.work = 2.0e6;
+	option.repeat = 3;
+	option.tolerance = 15.0;
+
+	for (int iarg = 1; iarg + 1 < argc; iarg += 2)
+	{
+		std::string key = argv[iarg];
+		std::string value = argv[iarg + 1];
+		if (key == "--cells") option.num_cell = parseList(value);
+		else if (key == "--threads") option.num_thread = parseList(value);
+		else if (key == "--mode") option.mode = split(value);
+		else if (key == "--scenario") option.scenario = value;
+		else if (key == "--work") option.work = std::stod(value);
+		else if (key == "--repeat") option.repeat = std::stoi(value);
+		else if (key == "--tolerance") option.tolerance = std::stod(value);
+		else if (key == "--csv") option.csv = value;
+		else if (key == "--baseline") option.baseline = value;
+		else ERROR("unknown option " + key);
+	}
+	if (option.repeat < 1) ERROR("number of repeats");
+	for (const std::string& mode : option.mode)
+		if ((mode != "strong") && (mode != "weak")) ERROR("scaling mode " + mode);
+
+	// Solver messages off, advection speed of input file
+	SET_SPEED(0.5);
+	Alert::setSilent(true);
+
+	std::vector<Run> result;
+	std::cout << std::left << std::setw(12) << "scenario" << std::setw(8) << "mode" << std::right << std::setw(8) << "threads" << std::setw(10) << "cells"
+		<< std::setw(8) << "steps" << std::setw(12) << "wall(s)" << std::setw(14) << "cells/s" << std::setw(12) << "efficiency" << "\n";
+	for (const Scenario& test : scenario)
+	{
+		if ((option.scenario != "") && (test.name.find(option.scenario) == std::string::npos)) continue;
+		for (const std::string& mode : option.mode)
+		{
+			for (int_t cells : option.num_cell)
+			{
+				real_t reference = 0.0;
+				for (size_t ithread = 0; ithread < option.num_thread.size(); ++ithread)
+				{
+					ThreadPool::setNumThread(option.num_thread[ithread]);
+					Run run;
+					run.scenario = test.name;
+					run.mode = mode;
+					run.num_thread = ThreadPool::getNumThread();
+					run.num_cell = (mode == "weak") ? cells*run.num_thread : cells;
+					run.num_step = std::max(int_t(3), int_t(option.work / run.num_cell));
+
+					// Best of repeats
+					run.wall = 0.0;
+					for (int_t irepeat = 0; irepeat < option.repeat; ++irepeat)
+					{
+						real_t wall = march(test, run.num_cell, run.num_step);
+						if ((irepeat == 0) || (wall < run.wall)) run.wall = wall;
+					}
+					run.throughput = real_t(run.num_cell)*run.num_step / run.wall;
+					if (ithread == 0) reference = run.throughput / run.num_thread;
+					run.efficiency = run.throughput / run.num_thread / reference;
+					result.push_back(run);
+
+					std::cout << std::left << std::setw(12) << run.scenario << std::setw(8) << run.mode << std::right << std::setw(8) << run.num_thread
+						<< std::setw(10) << run.num_cell << std::setw(8) << run.num_step << std::fixed << std::setprecision(4) << std::setw(12) << run.wall
+						<< std::scientific << std::setprecision(3) << std::setw(14) << run.throughput << std::fixed << std::setprecision(2) << std::setw(12) << run.efficiency << "\n";
+				}
+			}
+		}
+	}
+
+	// CSV of results, same format as baseline file
+	if (option.csv != "")
+	{
+		std::ofstream file;
+		file.open(option.csv, std::ios::trunc);
+		if (!file.is_open()) ERROR("cannot open output file");
+		file.precision(9);
+		file << "scenario,mode,threads,cells,steps,wall,throughput,efficiency\n";
+		for (const Run& run : result)
+			file << run.scenario << "," << run.mode << "," << run.num_thread << "," << run.num_cell << "," << run.num_step << ","
+				<< run.wall << "," << run.throughput << "," << run.efficiency << "\n";
+		file.close();
+	}
+
+	// Regression gate against baseline
+	if (option.baseline == "") return 0;
+	std::map<Key, real_t> baseline = readBaseline(option.baseline);
+	int_t num_compare = 0;
+	int_t num_fail = 0;
+	for (const Run& run : result)
+	{
+		auto found = baseline.find(Key(run.scenario, run.mode, run.num_thread, run.num_cell));
+		if (found == baseline.end()) continue;
+		num_compare++;
+		const real_t change = 100.0*(run.throughput / found->second - 1.0);
+		if (change < -option.tolerance)
+		{
+			num_fail++;
+			std::cout << "REGRESSION " << run.scenario << " " << run.mode << " threads=" << run.num_thread << " cells=" << run.num_cell
+				<< " : " << std::fixed << std::setprecision(1) << change << "% (baseline " << std::scientific << std::setprecision(3) << found->second << " cells/s)\n";
+		}
+	}
+	std::cout << num_compare << " configurations compared with baseline, " << num_fail << " regressions beyond " << std::fixed << std::setprecision(1) << option.tolerance << "%\n";
+	return (num_fail > 0) ? 1 : 0;
+}
\ No newline at end of file
@@ -0,0 +1,128 @@
+// Standard headers before DataType.h (epsilon macro)
+#include <atomic>
+#include <cstdlib>
+#include <new>
+
+#include "../DataType.h"
+#include "../Grid.h"
+#include "../Zone.h"
+#include "../InitialCondition.h"
+#include "../Boundary.h"
+#include "../TimeIntegEuler.h"
+#include "../TimeIntegRK.h"
+#include "../TimeIntegLTS.h"
+#include "../SIMDKernel.h"
+#include "../ThreadPool.h"
+
+// Heap allocations of the steady-state step loop
+// Every time integrator marches a few warm-up steps, then further steps must not allocate on any thread.
+// Exit code 1 on any failure.
+
+// Allocations of all threads since start
+static std::atomic<long> num_alloc(0);
+
+void* operator new(std::size_t size)
+{
+	num_alloc.fetch_add(1, std::memory_order_relaxed);
+	void* ptr = std::malloc(size ? size : 1);
+	if (ptr == nullptr) throw std::bad_alloc();
+	return ptr;
+}
+
+void* operator new[](std::size_t size)
+{
+	return operator new(size);
+}
+
+void operator delete(void* ptr) noexcept
+{
+	std::free(ptr);
+}
+
+void operator delete[](void* ptr) noexcept
+{
+	std::free(ptr);
+}
+
+void operator delete(void* ptr, std::size_t) noexcept
+{
+	std::free(ptr);
+}
+
+void operator delete[](void* ptr, std::size_t) noexcept
+{
+	std::free(ptr);
+}
+
+// Case of the test
+struct AllocationCase
+{
+	Type timeInteg;
+	Type PDE;
+	Type limiter;
+	Type initial;
+	Type basis;
+	Type grid;
+	int_t polyOrder;
+	bool adaptiveOrder;
+};
+
+// Allocations of steady-state steps / p.m. case / r.t. number of allocations
+static long countAllocation(const AllocationCase& test)
+{
+	const int_t num_warmup = 5;
+	const int_t num_step = 20;
+
+	if (test.PDE == "advection") SET_SPEED(1.0);
+	std::shared_ptr<Grid> grid;
+	if (test.grid == "uniform") grid = std::make_shared<Grid>(2.0, 0.01, 0, 1);
+	else grid = std::make_shared<Grid>(Grid::makeNode(test.grid, 2.0, 0.01, std::vector<real_t>(1, 1.02), ""), 0, 1);
+
+	std::shared_ptr<Zone> zone = std::make_shared<Zone>(grid, test.polyOrder);
+	if (test.basis == "nodal") zone->setNodal(true);
+	zone->initialize(std::make_shared<InitialCondition>(test.initial));
+	zone->setAdaptiveOrder(test.adaptiveOrder);
+	std::shared_ptr<Boundary> bdry = std::make_shared<Boundary>("periodic", zone);
+
+	std::shared_ptr<TimeInteg> timeInteg;
+	if (test.timeInteg == "Euler") timeInteg = std::make_shared<TimeIntegEuler>(test.PDE, "godunov", test.limiter, 0.1, 100.0, zone, bdry);
+	else if (test.timeInteg == "RK3") timeInteg = std::make_shared<TimeIntegRK>(test.PDE, "godunov", test.limiter, 0.1, 100.0, zone, bdry, 3);
+	else timeInteg = std::make_shared<TimeIntegLTS>(test.PDE, "godunov", test.limiter, 0.1, 100.0, zone, bdry, 3);
+
+	for (int_t istep = 0; istep < num_warmup; ++istep) timeInteg->march(zone);
+	const long before = num_alloc.load();
+	for (int_t istep = 0; istep < num_step; ++istep) timeInteg->march(zone);
+	return num_alloc.load() - before;
+}
+
+int main()
+{
+	Alert::setSilent(true);
+	SIMDKernel::setLevel(SIMDKernel::select("auto"));
+	ThreadPool::setNumThread(4);
+
+	std::vector<AllocationCase> cases;
+	for (int_t polyOrder = 0; polyOrder <= 5; ++polyOrder)
+		cases.push_back({ "RK3", "advection", "MLP-u2", "square", "modal", "uniform", polyOrder, false });
+	cases.push_back({ "RK3", "advection", "MLP-u2", "square", "nodal", "uniform", 2, false });
+	cases.push_back({ "RK3", "advection", "MLP-u2", "square", "nodal", "uniform", 5, false });
+	cases.push_back({ "RK3", "advection", "MLP-u2", "square", "modal", "uniform", 2, true });
+	cases.push_back({ "RK3", "burgers", "MLP-u2", "sine", "modal", "uniform", 2, false });
+	cases.push_back({ "Euler", "advection", "MLP-u2", "square", "modal", "uniform", 1, false });
+	cases.push_back({ "Euler", "burgers", "MLP-u2", "shock", "modal", "uniform", 2, true });
+	cases.push_back({ "LTS-RK3", "advection", "MLP-u2", "square", "modal", "stretched", 2, false });
+	cases.push_back({ "LTS-RK3", "burgers", "MLP-u2", "sine", "modal", "stretched", 2, true });
+
+	int_t num_fail = 0;
+	for (const AllocationCase& test : cases)
+	{
+		const long count = countAllocation(test);
+		if (count == 0) continue;
+		std::cout << test.timeInteg << " " << test.PDE << " " << test.initial << " " << test.basis << " P" << test.polyOrder
+			<< (test.adaptiveOrder ? " adaptive" : "") << " : " << count << " allocations\n";
+		num_fail++;
+	}
+
+	std::cout << ((num_fail == 0) ? "Allocation test passed\n" : "Allocation test failed\n");
+	return (num_fail == 0) ? 0 : 1;
+}
\ No newline at end of file
@@ -0,0 +1,91 @@
+// Standard headers before DataType.h (epsilon macro)
+#include <iomanip>
+
+#include "../DataType.h"
+#include "../Grid.h"
+#include "../Zone.h"
+#include "../InitialCondition.h"
+#include "../Boundary.h"
+#include "../TimeIntegRK.h"
+#include "../Ensemble.h"
+#include "../SIMDKernel.h"
+#include "../ThreadPool.h"
+
+// Ensemble lanes against single-case runs
+// Lane 0 of an ensemble marches the case of a single RK3 run, the other lanes march different cases.
+// Advection lanes must reproduce the single run exactly, Burgers lanes to round-off (Ensemble.h).
+// Exit code 1 on any failure.
+
+// Case of the test
+struct EnsembleTestCase
+{
+	Type PDE;
+	Type limiter;
+	Type boundary;
+	Type initial;
+	int_t polyOrder;
+	real_t tolerance; /// maximum DOF difference
+};
+
+// Maximum DOF difference of real cells between lane 0 and single run / p.m. case, ensemble width / r.t. difference
+static real_t compare(const EnsembleTestCase& test, int_t width)
+{
+	const real_t targetTime = 0.5;
+	const EnsembleCase member = { 1.0, 1.0, 0.1 };
+	std::shared_ptr<Grid> grid = std::make_shared<Grid>(2.0, 0.02);
+
+	// Single run
+	SET_SPEED(member.speed);
+	std::shared_ptr<Zone> zone = std::make_shared<Zone>(grid, test.polyOrder);
+	zone->initialize(std::make_shared<InitialCondition>(test.initial, member.amplitude));
+	std::shared_ptr<Boundary> bdry = std::make_shared<Boundary>(test.boundary, zone);
+	TimeIntegRK timeInteg(test.PDE, "godunov", test.limiter, member.CFL, targetTime, zone, bdry, 3);
+	while (timeInteg.march(zone));
+
+	// Ensemble, other lanes with other speeds, amplitudes and CFL numbers
+	std::vector<EnsembleCase> cases(1, member);
+	for (int_t lane = 1; lane < width; ++lane)
+		cases.push_back({ -0.5*lane, 1.0 + 0.25*lane, 0.05*lane });
+	std::shared_ptr<Ensemble> ensemble = Ensemble::create(width, test.PDE, test.limiter, test.boundary, test.initial, targetTime, grid, test.polyOrder);
+	ensemble->initialize(cases);
+	while (ensemble->march());
+	std::shared_ptr<Zone> lane = std::make_shared<Zone>(grid, test.polyOrder);
+	ensemble->extract(0, lane);
+
+	real_t difference = std::abs(ensemble->getTime(0) - timeInteg.getTime());
+	for (int_t icell = GHOST; icell < grid->getNumCell() - GHOST; ++icell)
+		for (int_t idegree = 0; idegree <= test.polyOrder; ++idegree)
+			difference = std::max(difference, std::abs(lane->getDOF()(idegree, icell) - zone->getDOF()(idegree, icell)));
+	return difference;
+}
+
+int main()
+{
+	Alert::setSilent(true);
+	SIMDKernel::setLevel(SIMDKernel::select("auto"));
+
+	std::vector<EnsembleTestCase> cases;
+	for (int_t polyOrder = 0; polyOrder <= 2; ++polyOrder)
+	{
+		cases.push_back({ "advection", "MLP-u2", "periodic", "square", polyOrder, 0.0 });
+		cases.push_back({ "advection", "MLP-u1", "periodic", "sine", polyOrder, 0.0 });
+		cases.push_back({ "burgers", "MLP-u2", "periodic", "sine", polyOrder, 1.0e-12 });
+		cases.push_back({ "burgers", "MLP-u2", "constant", "shock", polyOrder, 1.0e-12 });
+	}
+
+	int_t num_fail = 0;
+	for (const EnsembleTestCase& test : cases)
+	{
+		for (int_t width : { 4, 8 })
+		{
+			const real_t difference = compare(test, width);
+			if (difference <= test.tolerance) continue;
+			std::cout << test.PDE << " " << test.limiter << " " << test.boundary << " " << test.initial << " P" << test.polyOrder
+				<< " width " << width << " : DOF difference " << std::setprecision(6) << difference << "\n";
+			num_fail++;
+		}
+	}
+
+	std::cout << ((num_fail == 0) ? "Ensemble test passed\n" : "Ensemble test failed\n");
+	return (num_fail == 0) ? 0 : 1;
+}
\ No newline at end of file
@@ -0,0 +1,57 @@
+#!/bin/sh
+# Gathered rank output against the serial run
+# Builds the serial and the MPI solver, runs every case on 1, 2 and 4 ranks and byte-compares
+# the final DG solutions of all ranks, concatenated in rank order, with the serial one.
+# Run from the repository root, exit code 1 on any failure.
+
+work=$(mktemp -d)
+trap 'rm -rf "$work"' EXIT
+sources=$(ls *.cpp)
+
+g++ -std=c++14 -O2 -pthread -o "$work/rkdg_serial" $sources || exit 1
+mpicxx -std=c++14 -O2 -pthread -DRKDG_USE_MPI -o "$work/rkdg_mpi" $sources || exit 1
+
+# Input file of a case / p.m. directory, PDE, initial, boundary, polynomial order, adaptive order
+setCase()
+{
+	mkdir -p "$1/output/test"
+	sed -e "s/^\\\$\\\$ PDE TYPE = .*/\$\$ PDE TYPE = $2/" \
+		-e "s/^\\\$\\\$ INITIAL = .*/\$\$ INITIAL = $3/" \
+		-e "s/^\\\$\\\$ BOUNDARY = .*/\$\$ BOUNDARY = $4/" \
+		-e "s/^\\\$\\\$ POLYNOMIAL ORDER = .*/\$\$ POLYNOMIAL ORDER = $5/" \
+		-e "s/^\\\$\\\$ ADAPTIVE ORDER = .*/\$\$ ADAPTIVE ORDER = $6/" \
+		-e "s/^\\\$\\\$ GRID SIZE = .*/\$\$ GRID SIZE = 0.02/" \
+		-e "s/^\\\$\\\$ TARGET TIME = .*/\$\$ TARGET TIME = 0.5/" \
+		-e "s/^\\\$\\\$ THREADS = .*/\$\$ THREADS = 1/" \
+		input.inp > "$1/input.inp"
+}
+
+num_fail=0
+for test in "advection square periodic 2 off" "advection sine periodic 1 off" "burgers sine periodic 2 on" "burgers shock constant 2 off"
+do
+	set -- $test
+	name="$1_$2_P$4_$5"
+	setCase "$work/serial" "$@"
+	(cd "$work/serial" && "$work/rkdg_serial" > log.txt 2>&1) || { echo "$name : serial run failed"; num_fail=$((num_fail + 1)); continue; }
+	tail -n +3 "$work"/serial/output/test/*DGsolution*_result.plt > "$work/serial.txt"
+
+	for np in 1 2 4
+	do
+		rm -rf "$work/mpi"
+		setCase "$work/mpi" "$@"
+		(cd "$work/mpi" && mpirun --allow-run-as-root --oversubscribe -np $np "$work/rkdg_mpi" > log.txt 2>&1)
+		if [ $np -eq 1 ]; then
+			tail -n +3 "$work"/mpi/output/test/*DGsolution*_result.plt > "$work/gather.txt"
+		else
+			for rank in $(seq 0 $((np - 1))); do tail -n +3 "$work"/mpi/output/test/*DGsolution*_result_rank$rank.plt; done > "$work/gather.txt"
+		fi
+		if [ -s "$work/gather.txt" ] && cmp -s "$work/serial.txt" "$work/gather.txt"; then continue; fi
+		echo "$name : $np ranks differ from serial run"
+		num_fail=$((num_fail + 1))
+	done
+	rm -rf "$work/serial"
+done
+
+if [ $num_fail -eq 0 ]; then echo "MPI test passed"; exit 0; fi
+echo "MPI test failed"
+exit 1
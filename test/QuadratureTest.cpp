@@ -0,0 +1,77 @@
+// Standard headers before DataType.h (epsilon macro)
+#include <iomanip>
+
+#include "../DataType.h"
+#include "../Quadrature.h"
+
+// Gauss and Gauss-Lobatto quadrature tables
+// Every number of points must integrate monomials up to degree 2n-1 (Lobatto : 2n-3) exactly on [-1, 1], weights sum to 2.
+// Exit code 1 on any failure.
+
+// Integral of x^k on [-1, 1]
+static real_t exactMonomial(int_t k)
+{
+	return (k % 2 == 0) ? 2.0 / (k + 1) : 0.0;
+}
+
+int main()
+{
+	const real_t tolerance = 1.0e-12;
+	int_t num_fail = 0;
+
+	for (int_t num = 1; num <= MAX_QUAD; ++num)
+	{
+		// Weight sum
+		real_t sum = 0.0;
+		for (int_t index = 0; index < num; ++index) sum += Gauss_W(num, index);
+		if (std::abs(sum - 2.0) > tolerance)
+		{
+			std::cout << "Gauss " << num << " points : weight sum " << std::setprecision(16) << sum << "\n";
+			num_fail++;
+		}
+
+		// Exactness up to degree 2n-1
+		for (int_t k = 0; k <= 2 * num - 1; ++k)
+		{
+			real_t integral = 0.0;
+			for (int_t index = 0; index < num; ++index) integral += Gauss_W(num, index)*pow(Gauss_X(num, index), k);
+			if (std::abs(integral - exactMonomial(k)) > tolerance)
+			{
+				std::cout << "Gauss " << num << " points : x^" << k << " integral " << std::setprecision(16) << integral << "\n";
+				num_fail++;
+			}
+		}
+	}
+
+	for (int_t num = 2; num <= MAX_QUAD; ++num)
+	{
+		// Weight sum
+		real_t sum = 0.0;
+		for (int_t index = 0; index < num; ++index) sum += Lobatto_W(num, index);
+		if (std::abs(sum - 2.0) > tolerance)
+		{
+			std::cout << "Lobatto " << num << " points : weight sum " << std::setprecision(16) << sum << "\n";
+			num_fail++;
+		}
+
+		// End points and exactness up to degree 2n-3
+		if ((Lobatto_X(num, 0) != -1.0) || (Lobatto_X(num, num - 1) != 1.0))
+		{
+			std::cout << "Lobatto " << num << " points : end points " << std::setprecision(16) << Lobatto_X(num, 0) << " " << Lobatto_X(num, num - 1) << "\n";
+			num_fail++;
+		}
+		for (int_t k = 0; k <= 2 * num - 3; ++k)
+		{
+			real_t integral = 0.0;
+			for (int_t index = 0; index < num; ++index) integral += Lobatto_W(num, index)*pow(Lobatto_X(num, index), k);
+			if (std::abs(integral - exactMonomial(k)) > tolerance)
+			{
+				std::cout << "Lobatto " << num << " points : x^" << k << " integral " << std::setprecision(16) << integral << "\n";
+				num_fail++;
+			}
+		}
+	}
+
+	std::cout << ((num_fail == 0) ? "Quadrature test passed\n" : "Quadrature test failed\n");
+	return (num_fail == 0) ? 0 : 1;
+}
\ No newline at end of file
@@ -0,0 +1,65 @@
+#!/bin/sh
+# Restarted run against the uninterrupted run
+# Every case runs once without checkpoints, then again with one checkpoint after 3/5 of its steps.
+# The run restarted from that checkpoint must write DG solutions and errors byte-identical to the uninterrupted run.
+# Run from the repository root, exit code 1 on any failure.
+
+work=$(mktemp -d)
+trap 'rm -rf "$work"' EXIT
+
+g++ -std=c++14 -O2 -pthread -o "$work/rkdg" $(ls *.cpp) || exit 1
+
+# Input file of a case / p.m. directory, PDE, initial, boundary, polynomial order, adaptive order, time integration, grid type, output format
+setCase()
+{
+	mkdir -p "$1/output/test"
+	sed -e "s/^\\\$\\\$ PDE TYPE = .*/\$\$ PDE TYPE = $2/" \
+		-e "s/^\\\$\\\$ INITIAL = .*/\$\$ INITIAL = $3/" \
+		-e "s/^\\\$\\\$ BOUNDARY = .*/\$\$ BOUNDARY = $4/" \
+		-e "s/^\\\$\\\$ POLYNOMIAL ORDER = .*/\$\$ POLYNOMIAL ORDER = $5/" \
+		-e "s/^\\\$\\\$ ADAPTIVE ORDER = .*/\$\$ ADAPTIVE ORDER = $6/" \
+		-e "s/^\\\$\\\$ TIME INTEGRATION = .*/\$\$ TIME INTEGRATION = $7/" \
+		-e "s/^\\\$\\\$ GRID TYPE = .*/\$\$ GRID TYPE = $8/" \
+		-e "s/^\\\$\\\$ OUTPUT FORMAT = .*/\$\$ OUTPUT FORMAT = $9/" \
+		-e "s/^\\\$\\\$ GRID SIZE = .*/\$\$ GRID SIZE = 0.02/" \
+		-e "s/^\\\$\\\$ TARGET TIME = .*/\$\$ TARGET TIME = 0.5/" \
+		-e "s/^\\\$\\\$ CHECKPOINT STEPS = .*/\$\$ CHECKPOINT STEPS = ${10}/" \
+		input.inp > "$1/input.inp"
+}
+
+num_fail=0
+for test in "advection square periodic 2 off RK3 uniform plt" "burgers shock constant 2 on RK3 uniform plt" \
+	"advection sine periodic 1 off Euler uniform plt" "burgers sine periodic 2 on LTS-RK3 stretched plt" "advection square periodic 2 off RK3 uniform binary"
+do
+	set -- $test
+	name="$1_$2_P$4_$5_$6_$7_$8"
+
+	# Uninterrupted run, one DG solution per step
+	setCase "$work/full" "$@" 0
+	(cd "$work/full" && "$work/rkdg" > log.txt 2>&1) || { echo "$name : run failed"; num_fail=$((num_fail + 1)); continue; }
+	num_step=$(ls "$work/full/output/test" | grep -c "_result[0-9][0-9]*\.\(plt\|rkb\)$")
+	checkpoint=$((num_step * 3 / 5))
+
+	# Checkpoint once, then restart without the outputs of the first run
+	setCase "$work/restart" "$@" $checkpoint
+	(cd "$work/restart" && "$work/rkdg" > log1.txt 2>&1 && rm -f output/test/*.plt output/test/*.rkb \
+		&& "$work/rkdg" --restart ./output/test/RKDG_1D_checkpoint.rkc > log.txt 2>&1) || { echo "$name : restart failed"; num_fail=$((num_fail + 1)); rm -rf "$work/full" "$work/restart"; continue; }
+
+	result=""
+	num_diff=0
+	for file in $(cd "$work/restart/output/test" && ls *.plt *.rkb 2>/dev/null); do
+		cmp -s "$work/full/output/test/$file" "$work/restart/output/test/$file" || num_diff=$((num_diff + 1))
+	done
+	[ $num_diff -eq 0 ] || result="$result $num_diff-files"
+	[ "$(grep error "$work/full/log.txt")" = "$(grep error "$work/restart/log.txt")" ] || result="$result errors"
+	[ -n "$(ls "$work/restart/output/test" | grep "_result\.\(plt\|rkb\)$")" ] || result="$result final-solution"
+	if [ -n "$result" ]; then
+		echo "$name : restart at step $checkpoint of $num_step differs :$result"
+		num_fail=$((num_fail + 1))
+	fi
+	rm -rf "$work/full" "$work/restart"
+done
+
+if [ $num_fail -eq 0 ]; then echo "Restart test passed"; exit 0; fi
+echo "Restart test failed"
+exit 1
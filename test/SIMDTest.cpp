@@ -0,0 +1,122 @@
+// Standard headers before DataType.h (epsilon macro)
+#include <iomanip>
+#include <random>
+
+#include "../DataType.h"
+#include "../Grid.h"
+#include "../Zone.h"
+#include "../DGbasis.h"
+#include "../RHSKernel.h"
+#include "../SIMDKernel.h"
+
+// Vectorized RHS sweeps against the scalar RHS kernel
+// Every instruction set supported by the CPU builds the RHS of random and nearly constant DOF.
+// Advection must be bitwise identical, Burgers within the flux tolerance of SIMDKernel.h.
+// Exit code 1 on any failure.
+
+// Level name / p.m. instruction set / r.t. name
+static Type levelName(SIMDLevel level)
+{
+	if (level == SIMDLevel::AVX512) return "avx512";
+	if (level == SIMDLevel::AVX2) return "avx2";
+	return "scalar";
+}
+
+// RHS of the zone / p.m. instruction set, Equation type, Zone / r.t. RHS
+static DOFArray computeRHS(SIMDLevel level, const Type& PDE, std::shared_ptr<Zone> zone)
+{
+	SIMDKernel::setLevel(level);
+	std::shared_ptr<RHSKernel> kernel = RHSKernel::create(zone->getPolyOrder(), PDE, "godunov", zone->getGrid()->getNumCell());
+	DOFArray RHS(zone->getPolyOrder() + 1, zone->getGrid()->getNumCell(), Layout::SoA);
+	kernel->compute(zone, RHS);
+	return RHS;
+}
+
+// Zone of random cells, a nearly constant plateau and a few reduced-order cells / p.m. Grid, polynomial order / r.t. Zone
+static std::shared_ptr<Zone> makeZone(std::shared_ptr<Grid> grid, int_t polyOrder)
+{
+	const int_t num_cell = grid->getNumCell();
+	std::shared_ptr<Zone> zone = std::make_shared<Zone>(grid, polyOrder, "SoA");
+	DOFArray& DOF = zone->getDOF();
+	std::mt19937 generator(polyOrder*num_cell + 1);
+	std::uniform_real_distribution<real_t> dist(-1.0, 1.0);
+
+	for (int_t icell = 0; icell < num_cell; ++icell)
+	{
+		// Plateau of the middle third, faces with |uL - uR| below epsilon
+		const bool plateau = (3 * icell >= num_cell) && (3 * icell < 2 * num_cell);
+		for (int_t idegree = 0; idegree <= polyOrder; ++idegree)
+		{
+			if (plateau) DOF(idegree, icell) = (idegree == 0) ? 0.7 + 1.0e-10*icell : 0.0;
+			else DOF(idegree, icell) = dist(generator) / (idegree + 1);
+		}
+	}
+
+	std::vector<int_t> degree(num_cell, polyOrder);
+	for (int_t icell = GHOST + 5; icell < num_cell - GHOST; icell += 17)
+		degree[icell] = icell % (polyOrder + 1);
+	zone->setDegree(degree);
+	return zone;
+}
+
+// Maximum face solution of the zone / p.m. Zone / r.t. maximum |u| at faces
+static real_t maxFaceSolution(std::shared_ptr<Zone> zone)
+{
+	const DOFArray& DOF = zone->getDOF();
+	real_t maxU = 0.0;
+	for (int_t icell = 0; icell < zone->getGrid()->getNumCell(); ++icell)
+	{
+		real_t bound = 0.0;
+		for (int_t idegree = 0; idegree <= zone->getPolyOrder(); ++idegree)
+			bound += (2 * idegree + 1) / DGbasis::legendreScale(idegree)*std::abs(DOF(idegree, icell));
+		maxU = std::max(maxU, bound);
+	}
+	return maxU;
+}
+
+int main()
+{
+	Alert::setSilent(true);
+	const SIMDLevel best = SIMDKernel::detect();
+	std::vector<SIMDLevel> levels;
+	if (best != SIMDLevel::Scalar) levels.push_back(SIMDLevel::AVX2);
+	if (best == SIMDLevel::AVX512) levels.push_back(SIMDLevel::AVX512);
+	std::cout << "Best instruction set : " << levelName(best) << "\n";
+
+	// Odd number of cells, remainder cells of 4 and 8 lanes
+	std::shared_ptr<Grid> grid = std::make_shared<Grid>(2.0, 2.0 / 101.0);
+	const real_t inv_sizeX = *std::max_element(grid->getInvSizeX().begin(), grid->getInvSizeX().end());
+
+	int_t num_fail = 0;
+	for (const Type& PDE : { Type("advection"), Type("burgers") })
+	{
+		SET_SPEED(-0.75);
+		for (int_t polyOrder = 0; polyOrder <= SIMD_MAX_ORDER; ++polyOrder)
+		{
+			std::shared_ptr<Zone> zone = makeZone(grid, polyOrder);
+			const DOFArray reference = computeRHS(SIMDLevel::Scalar, PDE, zone);
+
+			// Flux differs by max(|uL|,|uR|)*epsilon, reaching the RHS through both faces of a cell
+			real_t tolerance = 0.0;
+			if (PDE == "burgers")
+				for (int_t idegree = 0; idegree <= polyOrder; ++idegree)
+					tolerance = std::max(tolerance, 2.0*DGbasis::legendreScale(idegree)*maxFaceSolution(zone)*epsilon*inv_sizeX);
+
+			for (SIMDLevel level : levels)
+			{
+				const DOFArray RHS = computeRHS(level, PDE, zone);
+				real_t difference = 0.0;
+				for (int_t icell = 0; icell < grid->getNumCell(); ++icell)
+					for (int_t idegree = 0; idegree <= polyOrder; ++idegree)
+						difference = std::max(difference, std::abs(RHS(idegree, icell) - reference(idegree, icell)));
+				if (difference <= tolerance) continue;
+				std::cout << PDE << " P" << polyOrder << " " << levelName(level) << " : RHS difference " << std::setprecision(6) << difference
+					<< " > " << tolerance << "\n";
+				num_fail++;
+			}
+		}
+	}
+
+	std::cout << ((num_fail == 0) ? "SIMD test passed\n" : "SIMD test failed\n");
+	return (num_fail == 0) ? 0 : 1;
+}
\ No newline at end of file